@@ -0,0 +1,118 @@
+/**
+  ******************************************************************************
+  * @file    anim.c
+  * @brief   Flash-resident compressed animation player
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  */
+
+  #include "anim.h"
+  #include "gn1640t.h"
+
+  /*============================================================================*/
+  /* STATE                                                                      */
+  /*============================================================================*/
+
+  static const uint8_t *anim_stream;   /* start, for looping */
+  static const uint8_t *anim_pos;      /* next frame, 0 = stopped */
+  static uint8_t anim_wait;            /* ticks left on this frame */
+  static uint8_t anim_loop;
+
+  /*============================================================================*/
+  /* DECODER                                                                    */
+  /*============================================================================*/
+
+  /* Decode one frame into displayBuffer and send its changed window */
+  static void anim_next_frame(void)
+  {
+      const uint8_t *p = anim_pos;
+      uint8_t delay, runs, hdr, grid, len, skip;
+      uint8_t lo = GN1640_GRIDS;
+      uint8_t hi = 0;
+
+      delay = *p++;
+      if (delay == 0) {
+          if (!anim_loop || *anim_stream == 0) {
+              anim_pos = 0;
+              return;
+          }
+          p = anim_stream;
+          delay = *p++;
+      }
+
+      runs = *p++;
+      while (runs--) {
+          hdr = *p++;
+          grid = (uint8_t)(hdr >> 4);
+          len = (uint8_t)((hdr & 0x0F) + 1);
+
+          /* A bad header must not run past displayBuffer; skip the excess
+           * data so the stream stays in step */
+          skip = 0;
+          if (len > (uint8_t)(GN1640_GRIDS - grid)) {
+              skip = (uint8_t)(len - (GN1640_GRIDS - grid));
+              len = (uint8_t)(GN1640_GRIDS - grid);
+          }
+
+          if (grid < lo) {
+              lo = grid;
+          }
+          if ((uint8_t)(grid + len) > hi) {
+              hi = (uint8_t)(grid + len);
+          }
+          while (len--) {
+              displayBuffer[grid++] = *p++;
+          }
+          p += skip;
+      }
+
+      if (lo < hi) {
+          GN1640_UpdateRange(lo, (uint8_t)(hi - lo));
+      }
+
+      anim_pos = p;
+      anim_wait = delay;
+  }
+
+  /*============================================================================*/
+  /* PLAYER FUNCTIONS                                                           */
+  /*============================================================================*/
+
+  void Anim_Start(const uint8_t *stream, uint8_t loop)
+  {
+      uint8_t g;
+
+      for (g = 0; g < GN1640_GRIDS; g++) {
+          displayBuffer[g] = 0;
+      }
+
+      anim_stream = stream;
+      anim_pos = stream;
+      anim_loop = loop;
+      anim_next_frame();
+
+      /* Frame 0 only lists lit grids; blank any leftovers from before */
+      GN1640_Flush();
+  }
+
+  void Anim_Tick(void)
+  {
+      if (anim_pos == 0) {
+          return;
+      }
+      if (--anim_wait == 0) {
+          anim_next_frame();
+      }
+  }
+
+  void Anim_Stop(void)
+  {
+      anim_pos = 0;
+  }
+
+  uint8_t Anim_Busy(void)
+  {
+      return (uint8_t)(anim_pos != 0);
+  }
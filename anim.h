@@ -0,0 +1,71 @@
+/**
+  ******************************************************************************
+  * @file    anim.h
+  * @brief   Flash-resident compressed animation player
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  * @description
+  * Plays frame sequences stored in flash as runs of changed grids, so a
+  * boot logo or idle animation costs a few bytes per frame instead of 16.
+  * The player decodes straight into displayBuffer, sends one frame with
+  * only the changed grid window, and keeps 6 bytes of RAM state.
+  *
+  * Stream format (build it with tools/anim_encode.c):
+  *
+  *   stream := frame* 0x00
+  *   frame  := DELAY NRUNS run[NRUNS]
+  *   DELAY  := 1-255, time to hold the frame in ANIM_TICK_MS units
+  *             (0 ends the stream). Longer holds are followed by
+  *             frames with NRUNS 0.
+  *   NRUNS  := 0-16, number of runs that follow
+  *   run    := HDR data[len]
+  *   HDR    := (first_grid << 4) | (len - 1)
+  *
+  * Each frame only lists the grids that differ from the previous frame.
+  * Playback starts from a blank buffer. Streams built for looping encode
+  * their first frame against the last frame as well.
+  ******************************************************************************
+  */
+
+  #ifndef __ANIM_H
+  #define __ANIM_H
+
+  #include "stm8s.h"
+
+  /*============================================================================*/
+  /* PLAYER PARAMETERS                                                          */
+  /*============================================================================*/
+
+  #define ANIM_TICK_MS      10    // Delay unit, Anim_Tick() call period
+
+  /*============================================================================*/
+  /* PLAYER FUNCTIONS                                                           */
+  /*============================================================================*/
+
+  /**
+   * @brief Clear displayBuffer and show the first frame of a stream
+   * @param stream: Encoded animation in flash
+   * @param loop: 1=restart at the end, 0=stop on the last frame
+   */
+  void Anim_Start(const uint8_t *stream, uint8_t loop);
+
+  /**
+   * @brief Advance playback - call every ANIM_TICK_MS
+   * @note Fits Sched_AddTask(Anim_Tick, ANIM_TICK_MS) directly
+   */
+  void Anim_Tick(void);
+
+  /**
+   * @brief Stop playback, leaving the current frame on the display
+   */
+  void Anim_Stop(void);
+
+  /**
+   * @brief Check whether an animation is playing
+   * @return 1 if playing, 0 if stopped or finished
+   */
+  uint8_t Anim_Busy(void);
+
+  #endif /* __ANIM_H */
@@ -0,0 +1,234 @@
+/**
+  ******************************************************************************
+  * @file    busarb.c
+  * @brief   PB4/PB5 bus arbiter for GN1640T frames and hardware I2C traffic
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  */
+
+  #include "busarb.h"
+  #include "gn1640t.h"
+
+  #define BUSARB_CC_I1I0       0x28  /* CC interrupt mask bits, both set = masked */
+
+  /*============================================================================*/
+  /* STATE                                                                      */
+  /*============================================================================*/
+
+  static busarb_xfer_t *busarb_queue[BUSARB_QUEUE_LEN];
+  static uint8_t busarb_head;      /* next slot to fill */
+  static uint8_t busarb_tail;      /* next transfer to run */
+  static busarb_display_fn_t busarb_display = GN1640_Flush;
+
+  /*============================================================================*/
+  /* I2C MASTER (polled, PB4/PB5 owned by the peripheral)                       */
+  /*============================================================================*/
+
+  static uint8_t busarb_wait(I2C_Event_TypeDef event)
+  {
+      uint16_t timeout = BUSARB_I2C_TIMEOUT;
+
+      while (I2C_CheckEvent(event) == ERROR) {
+          if (--timeout == 0) {
+              return 0;
+          }
+      }
+      return 1;
+  }
+
+  static uint8_t busarb_wait_flag(I2C_Flag_TypeDef flag)
+  {
+      uint16_t timeout = BUSARB_I2C_TIMEOUT;
+
+      while (I2C_GetFlagStatus(flag) == RESET) {
+          if (--timeout == 0) {
+              return 0;
+          }
+      }
+      return 1;
+  }
+
+  static uint8_t busarb_i2c_address(uint8_t addr, I2C_Direction_TypeDef dir,
+                                    I2C_Event_TypeDef event)
+  {
+      I2C_GenerateSTART(ENABLE);
+      if (!busarb_wait(I2C_EVENT_MASTER_MODE_SELECT)) {
+          return 0;
+      }
+      I2C_Send7bitAddress((uint8_t)(addr << 1), dir);
+      return busarb_wait(event);
+  }
+
+  /* RM0016 receive steps that must not be split by an ISR. The caller's
+   * mask is restored afterwards, so masked callers stay masked. */
+  static uint8_t busarb_irq_off(void)
+  {
+      uint8_t cc = ITC_GetCPUCC();
+
+      disableInterrupts();
+      return cc;
+  }
+
+  static void busarb_irq_restore(uint8_t cc)
+  {
+      if ((cc & BUSARB_CC_I1I0) != BUSARB_CC_I1I0) {
+          enableInterrupts();
+      }
+  }
+
+  /* Returns 1 on success. On failure the caller generates STOP. */
+  static uint8_t busarb_i2c_run(busarb_xfer_t *x)
+  {
+      uint8_t i, n, ok;
+      uint8_t cc = 0;
+
+      if (x->tx_len) {
+          if (!busarb_i2c_address(x->addr, I2C_DIRECTION_TX,
+                                  I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED)) {
+              return 0;
+          }
+          for (i = 0; i < x->tx_len; i++) {
+              I2C_SendData(x->tx[i]);
+              if (!busarb_wait(I2C_EVENT_MASTER_BYTE_TRANSMITTED)) {
+                  return 0;
+              }
+          }
+      }
+
+      if (x->rx_len) {
+          n = x->rx_len;
+          if (n == 1) {
+              /* NACK must be set before ADDR is cleared, and STOP must
+               * follow the ADDR clear before the byte completes */
+              I2C_AcknowledgeConfig(I2C_ACK_NONE);
+              cc = busarb_irq_off();
+          } else if (n == 2) {
+              /* POS: the ACK bit applies to the byte after the current one */
+              I2C_AcknowledgeConfig(I2C_ACK_NEXT);
+          }
+          ok = busarb_i2c_address(x->addr, I2C_DIRECTION_RX,
+                                  I2C_EVENT_MASTER_RECEIVER_MODE_SELECTED);
+          if (n == 1) {
+              if (ok) {
+                  I2C_GenerateSTOP(ENABLE);
+              }
+              busarb_irq_restore(cc);
+          }
+          if (!ok) {
+              return 0;
+          }
+
+          if (n == 1) {
+              if (!busarb_wait_flag(I2C_FLAG_RXNOTEMPTY)) {
+                  return 0;
+              }
+              x->rx[0] = I2C_ReceiveData();
+          } else if (n == 2) {
+              /* NACK the second byte; BTF holds both until STOP is set */
+              I2C_AcknowledgeConfig(I2C_ACK_NONE);
+              if (!busarb_wait_flag(I2C_FLAG_TRANSFERFINISHED)) {
+                  return 0;
+              }
+              cc = busarb_irq_off();
+              I2C_GenerateSTOP(ENABLE);
+              x->rx[0] = I2C_ReceiveData();
+              busarb_irq_restore(cc);
+              x->rx[1] = I2C_ReceiveData();
+          } else {
+              for (i = 0; i < (uint8_t)(n - 3); i++) {
+                  if (!busarb_wait_flag(I2C_FLAG_RXNOTEMPTY)) {
+                      return 0;
+                  }
+                  x->rx[i] = I2C_ReceiveData();
+              }
+              /* BTF: byte N-2 in DR, N-1 in the shift register, SCL held */
+              if (!busarb_wait_flag(I2C_FLAG_TRANSFERFINISHED)) {
+                  return 0;
+              }
+              I2C_AcknowledgeConfig(I2C_ACK_NONE);
+              x->rx[n - 3] = I2C_ReceiveData();
+              /* BTF: byte N-1 in DR, N (NACKed) in the shift register */
+              if (!busarb_wait_flag(I2C_FLAG_TRANSFERFINISHED)) {
+                  return 0;
+              }
+              cc = busarb_irq_off();
+              I2C_GenerateSTOP(ENABLE);
+              x->rx[n - 2] = I2C_ReceiveData();
+              busarb_irq_restore(cc);
+              if (!busarb_wait_flag(I2C_FLAG_RXNOTEMPTY)) {
+                  return 0;
+              }
+              x->rx[n - 1] = I2C_ReceiveData();
+          }
+
+          /* Back to ACK on the current byte, POS cleared */
+          I2C_AcknowledgeConfig(I2C_ACK_CURR);
+          return 1;
+      }
+
+      I2C_GenerateSTOP(ENABLE);
+      return 1;
+  }
+
+  static void busarb_i2c_transfer(busarb_xfer_t *x)
+  {
+      if (busarb_i2c_run(x)) {
+          x->status = BUSARB_DONE;
+      } else {
+          I2C_GenerateSTOP(ENABLE);
+          I2C_AcknowledgeConfig(I2C_ACK_CURR);
+          x->status = BUSARB_ERROR;
+      }
+  }
+
+  /*============================================================================*/
+  /* ARBITER FUNCTIONS                                                          */
+  /*============================================================================*/
+
+  void BusArb_Init(void)
+  {
+      busarb_head = 0;
+      busarb_tail = 0;
+      busarb_display = GN1640_Flush;
+  }
+
+  uint8_t BusArb_SubmitI2C(busarb_xfer_t *xfer)
+  {
+      /* Nothing to address: would end in a STOP without a START */
+      if (xfer->tx_len == 0 && xfer->rx_len == 0) {
+          return 0;
+      }
+      if ((uint8_t)(busarb_head - busarb_tail) >= BUSARB_QUEUE_LEN) {
+          return 0;
+      }
+      xfer->status = BUSARB_PENDING;
+      busarb_queue[busarb_head & (BUSARB_QUEUE_LEN - 1)] = xfer;
+      busarb_head++;
+      return 1;
+  }
+
+  void BusArb_SetDisplayHook(busarb_display_fn_t fn)
+  {
+      busarb_display = fn;
+  }
+
+  void BusArb_Poll(void)
+  {
+      uint8_t n;
+
+      /* Display slot: pins are taken only if the hook sends a frame, and
+       * kept afterwards so consecutive slots need no reconfiguration */
+      if (busarb_display) {
+          GN1640_BusHold(1);
+          busarb_display();
+      }
+
+      /* I2C slot: hand the pins back only when there is traffic */
+      for (n = 0; n < BUSARB_I2C_BURST && busarb_tail != busarb_head; n++) {
+          GN1640_BusHold(0);
+          busarb_i2c_transfer(busarb_queue[busarb_tail & (BUSARB_QUEUE_LEN - 1)]);
+          busarb_tail++;
+      }
+  }
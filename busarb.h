@@ -0,0 +1,98 @@
+/**
+  ******************************************************************************
+  * @file    busarb.h
+  * @brief   PB4/PB5 bus arbiter for GN1640T frames and hardware I2C traffic
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  * @description
+  * The GN1640T and real I2C devices share PB4/PB5. The GN1640T is driven
+  * by bit-banging with the I2C peripheral disabled, so the two must never
+  * overlap. The arbiter owns the pins and hands them out between whole
+  * transactions, from the main loop only.
+  *
+  * Scheduling, once per BusArb_Poll():
+  * - Display slot: runs the display hook (default GN1640_Flush), at most
+  *   one flush of up to 17 bytes
+  * - I2C slot: runs up to BUSARB_I2C_BURST queued transfers
+  *
+  * Worst-case latency therefore stays bounded for both clients: a display
+  * update waits for at most BUSARB_I2C_BURST transfers, and a queued
+  * transfer waits for at most one flush per burst ahead of it.
+  *
+  * The pins are only reconfigured when ownership actually changes. Back to
+  * back display slots with no I2C traffic in between keep PB4/PB5 as GPIO.
+  *
+  * All I2C traffic on PB4/PB5 must go through BusArb_SubmitI2C().
+  ******************************************************************************
+  */
+
+  #ifndef __BUSARB_H
+  #define __BUSARB_H
+
+  #include "stm8s.h"
+
+  /*============================================================================*/
+  /* ARBITER PARAMETERS                                                         */
+  /*============================================================================*/
+
+  #define BUSARB_QUEUE_LEN     4       // Pending I2C transfers (power of 2)
+  #define BUSARB_I2C_BURST     2       // Max I2C transfers per display slot
+  #define BUSARB_I2C_TIMEOUT   2000    // Poll iterations per I2C event
+
+  /*============================================================================*/
+  /* TRANSFER DESCRIPTOR                                                        */
+  /*============================================================================*/
+
+  #define BUSARB_IDLE          0       // Never submitted
+  #define BUSARB_PENDING       1       // Queued, not finished yet
+  #define BUSARB_DONE          2       // Completed successfully
+  #define BUSARB_ERROR         3       // Timed out or not acknowledged
+
+  // Write tx[0..tx_len-1], then (repeated START) read rx[0..rx_len-1].
+  // Either length may be 0, but not both. The descriptor and buffers are owned by the
+  // caller and must stay valid until status leaves BUSARB_PENDING.
+  typedef struct {
+      uint8_t addr;                // 7-bit slave address
+      const uint8_t *tx;           // Bytes to write
+      uint8_t tx_len;
+      uint8_t *rx;                 // Buffer for bytes read
+      uint8_t rx_len;
+      volatile uint8_t status;     // BUSARB_PENDING/DONE/ERROR
+  } busarb_xfer_t;
+
+  typedef uint8_t (*busarb_display_fn_t)(void);
+
+  /*============================================================================*/
+  /* ARBITER FUNCTIONS                                                          */
+  /*============================================================================*/
+
+  /**
+   * @brief Reset the queue and select GN1640_Flush as the display hook
+   * @note Call after I2C_Init() and GN1640_Init()
+   */
+  void BusArb_Init(void);
+
+  /**
+   * @brief Queue an I2C transfer
+   * @param xfer: Caller-owned descriptor, status becomes BUSARB_PENDING
+   * @return 1 if queued, 0 if the queue is full or both lengths are 0
+   * @note Main context only. Reads mask interrupts for a few instructions
+   *       around STOP, as RM0016 requires
+   */
+  uint8_t BusArb_SubmitI2C(busarb_xfer_t *xfer);
+
+  /**
+   * @brief Set the function run in the display slot
+   * @param fn: Returns 1 if it sent anything (GN1640_Flush signature)
+   */
+  void BusArb_SetDisplayHook(busarb_display_fn_t fn);
+
+  /**
+   * @brief Run one display slot and one I2C slot
+   * @note Fits Sched_SetFlushHook() directly
+   */
+  void BusArb_Poll(void);
+
+  #endif /* __BUSARB_H */
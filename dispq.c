@@ -0,0 +1,132 @@
+/**
+  ******************************************************************************
+  * @file    dispq.c
+  * @brief   Lock-free display command queue for ISR producers
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  */
+
+  #include "dispq.h"
+  #include "gn1640t.h"
+
+  /*============================================================================*/
+  /* TYPES AND STATE                                                            */
+  /*============================================================================*/
+
+  #define DISPQ_OP_CHAR        1
+  #define DISPQ_OP_SEGMENTS    2
+  #define DISPQ_OP_BRIGHTNESS  3
+  #define DISPQ_OP_FLUSH       4
+
+  typedef struct {
+      uint8_t op;
+      uint8_t arg;          /* digit or brightness */
+      uint16_t value;       /* character or segment mask */
+  } dispq_cmd_t;
+
+  /* Free-running indices: head is written only by the producer, tail only
+   * by the consumer. Single-byte stores are atomic on STM8, so neither side
+   * needs to mask interrupts. */
+  static volatile dispq_cmd_t dispq_ring[DISPQ_LEN];
+  static volatile uint8_t dispq_head;
+  static volatile uint8_t dispq_tail;
+
+  /*============================================================================*/
+  /* PRODUCER FUNCTIONS                                                         */
+  /*============================================================================*/
+
+  static uint8_t dispq_push(uint8_t op, uint8_t arg, uint16_t value)
+  {
+      uint8_t head = dispq_head;
+      volatile dispq_cmd_t *cmd;
+
+      if ((uint8_t)(head - dispq_tail) >= DISPQ_LEN) {
+          return 0;
+      }
+
+      cmd = &dispq_ring[head & (DISPQ_LEN - 1)];
+      cmd->op = op;
+      cmd->arg = arg;
+      cmd->value = value;
+
+      /* Publish only after the entry is complete */
+      dispq_head = (uint8_t)(head + 1);
+      return 1;
+  }
+
+  uint8_t DispQ_SetChar(uint8_t digit, char ch)
+  {
+      return dispq_push(DISPQ_OP_CHAR, digit, (uint8_t)ch);
+  }
+
+  uint8_t DispQ_SetSegments(uint8_t digit, uint16_t segment_mask)
+  {
+      return dispq_push(DISPQ_OP_SEGMENTS, digit, segment_mask);
+  }
+
+  uint8_t DispQ_SetBrightness(uint8_t brightness)
+  {
+      return dispq_push(DISPQ_OP_BRIGHTNESS, brightness, 0);
+  }
+
+  uint8_t DispQ_Flush(void)
+  {
+      return dispq_push(DISPQ_OP_FLUSH, 0, 0);
+  }
+
+  /*============================================================================*/
+  /* CONSUMER FUNCTIONS                                                         */
+  /*============================================================================*/
+
+  uint8_t DispQ_Service(void)
+  {
+      uint8_t tail = dispq_tail;
+      uint8_t head = dispq_head;
+      uint8_t end = tail;
+      uint8_t i;
+      uint8_t brightness = 0xFF;
+      volatile dispq_cmd_t *cmd;
+
+      /* Apply only up to the last flush marker. Commands behind it belong
+       * to a picture the producer has not finished yet and stay queued. */
+      for (i = tail; i != head; i++) {
+          if (dispq_ring[i & (DISPQ_LEN - 1)].op == DISPQ_OP_FLUSH) {
+              end = (uint8_t)(i + 1);
+          }
+      }
+
+      /* Later commands for the same digit simply overwrite earlier ones in
+       * displayBuffer, so any number of updates cost one frame below */
+      while (tail != end) {
+          cmd = &dispq_ring[tail & (DISPQ_LEN - 1)];
+
+          switch (cmd->op) {
+              case DISPQ_OP_CHAR:
+                  GN1640_DisplayChar(cmd->arg, (char)cmd->value);
+                  break;
+
+              case DISPQ_OP_SEGMENTS:
+                  GN1640_SetDigitSegments(cmd->arg, cmd->value);
+                  break;
+
+              case DISPQ_OP_BRIGHTNESS:
+                  brightness = cmd->arg;
+                  break;
+
+              default:     /* DISPQ_OP_FLUSH: marker only */
+                  break;
+          }
+
+          tail++;
+          dispq_tail = tail;
+      }
+
+      if (brightness != 0xFF) {
+          GN1640_SetBrightness(brightness);
+      }
+
+      /* Also carries displayBuffer edits made outside the queue */
+      return GN1640_Flush();
+  }
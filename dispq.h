@@ -0,0 +1,89 @@
+/**
+  ******************************************************************************
+  * @file    dispq.h
+  * @brief   Lock-free display command queue for ISR producers
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  * @description
+  * Lets UART, ADC and timer ISRs change the display without bit-banging a
+  * frame inside the interrupt. Producers push small commands in a few
+  * cycles. The main loop drains them with DispQ_Service(): font lookups
+  * happen there, all buffer changes are merged, and one GN1640_Flush()
+  * sends them in a single frame, together with any displayBuffer edits
+  * made by main-loop code since the last frame.
+  *
+  * Single producer, single consumer, no interrupt masking:
+  * - Producer side: ISRs. STM8 interrupts at the same software priority
+  *   (the default) do not preempt each other, so together they count as
+  *   one producer. Producing from the main loop as well needs interrupts
+  *   disabled around the call.
+  * - Consumer side: DispQ_Service() in the main loop only.
+  *
+  * DispQ_Flush() marks the end of a picture. DispQ_Service() applies
+  * commands only up to the last marker and leaves the rest queued, so a
+  * screen built over several ISR calls (e.g. one digit per UART byte) never
+  * shows half-finished. Producers must end each picture with DispQ_Flush().
+  *
+  * Under the scheduler, call Sched_Wake() after queueing so the main loop
+  * does not sleep until the next tick.
+  ******************************************************************************
+  */
+
+  #ifndef __DISPQ_H
+  #define __DISPQ_H
+
+  #include "stm8s.h"
+
+  /*============================================================================*/
+  /* QUEUE PARAMETERS                                                           */
+  /*============================================================================*/
+
+  #define DISPQ_LEN            16    // Queue entries (power of 2, max 128)
+
+  /*============================================================================*/
+  /* PRODUCER FUNCTIONS (ISR)                                                   */
+  /*============================================================================*/
+
+  /**
+   * @brief Queue a character for one digit
+   * @param digit: Digit position (0-5)
+   * @param ch: Character, looked up in the font when drained
+   * @return 1 if queued, 0 if the queue is full
+   */
+  uint8_t DispQ_SetChar(uint8_t digit, char ch);
+
+  /**
+   * @brief Queue a raw segment mask for one digit
+   * @param digit: Digit position (0-5)
+   * @param segment_mask: 16-bit mask of segments to turn on
+   * @return 1 if queued, 0 if the queue is full
+   */
+  uint8_t DispQ_SetSegments(uint8_t digit, uint16_t segment_mask);
+
+  /**
+   * @brief Queue a brightness change (only the last one drained is sent)
+   * @param brightness: 0-7
+   * @return 1 if queued, 0 if the queue is full
+   */
+  uint8_t DispQ_SetBrightness(uint8_t brightness);
+
+  /**
+   * @brief Mark the end of a picture - commands up to here go out together
+   * @return 1 if queued, 0 if the queue is full
+   */
+  uint8_t DispQ_Flush(void);
+
+  /*============================================================================*/
+  /* CONSUMER FUNCTIONS (main loop)                                             */
+  /*============================================================================*/
+
+  /**
+   * @brief Apply commands up to the last flush marker, then GN1640_Flush()
+   * @return 1 if a display frame was sent, 0 otherwise
+   * @note Fits BusArb_SetDisplayHook() and replaces GN1640_Flush() there
+   */
+  uint8_t DispQ_Service(void);
+
+  #endif /* __DISPQ_H */
@@ -9,6 +9,7 @@
   */
 
   #include "gn1640t.h"
+  #include "trace.h"
   #include <string.h>
 
   /*============================================================================*/
@@ -20,6 +21,18 @@
    * Bit 0 = digit 0, Bit 1 = digit 1, ..., Bit 5 = digit 5 */
   uint8_t displayBuffer[GN1640_GRIDS] = {0};
 
+  /* Copy of what the GN1640T currently holds. GN1640_Flush() compares it
+   * against displayBuffer so only the changed grids go out on the bus. */
+  static uint8_t gn1640_shadow[GN1640_GRIDS];
+
+  /* PB4/PB5 ownership. gn1640_bus_taken is set while the pins are GPIO;
+   * gn1640_bus_hold keeps them that way across frames (GN1640_BusHold). */
+  static uint8_t gn1640_bus_taken;
+  static uint8_t gn1640_bus_hold;
+
+  static uint8_t gn1640_brightness = BRIGHTNESS_MAX;
+  static uint8_t gn1640_display_on;
+
   /*============================================================================*/
   /* FONT TABLE - 16-SEGMENT CHARACTER DEFINITIONS                              */
   /*============================================================================*/
@@ -87,13 +100,32 @@
       }
   }
 
+  /* Borrow PB4/PB5 from the I2C peripheral (no-op if already ours) */
+  static void gn1640_bus_take(void)
+  {
+      if (!gn1640_bus_taken) {
+          I2C_Cmd(DISABLE);
+          GPIO_Init(GN1640_PORT, GN1640_CLK_PIN,  GPIO_MODE_OUT_PP_HIGH_FAST);
+          GPIO_Init(GN1640_PORT, GN1640_DATA_PIN, GPIO_MODE_OUT_PP_HIGH_FAST);
+          gn1640_bus_taken = 1;
+      }
+  }
+
+  /* Return PB4/PB5 to open-drain and re-enable I2C (no-op if not ours) */
+  static void gn1640_bus_give(void)
+  {
+      if (gn1640_bus_taken) {
+          GPIO_Init(GN1640_PORT, GN1640_CLK_PIN,  GPIO_MODE_OUT_OD_HIZ_FAST);
+          GPIO_Init(GN1640_PORT, GN1640_DATA_PIN, GPIO_MODE_OUT_OD_HIZ_FAST);
+          I2C_Cmd(ENABLE);
+          gn1640_bus_taken = 0;
+      }
+  }
+
   /* Pull CLK+DATA high, then pull DATA low while CLK is high = START */
   static void GN1640_Start(void)
   {
-      /* Borrow PB4/PB5 from the I2C peripheral */
-      I2C_Cmd(DISABLE);
-      GPIO_Init(GN1640_PORT, GN1640_CLK_PIN,  GPIO_MODE_OUT_PP_HIGH_FAST);
-      GPIO_Init(GN1640_PORT, GN1640_DATA_PIN, GPIO_MODE_OUT_PP_HIGH_FAST);
+      gn1640_bus_take();
 
       GPIO_WriteHigh(GN1640_PORT, GN1640_DATA_PIN);
       GPIO_WriteHigh(GN1640_PORT, GN1640_CLK_PIN);
@@ -103,7 +135,7 @@
   }
 
   /* Pull DATA low, then bring CLK high, then DATA high = STOP.
-   * Restores PB4/PB5 to open-drain and re-enables I2C. */
+   * Hands PB4/PB5 back to I2C unless GN1640_BusHold(1) is in effect. */
   static void GN1640_Stop(void)
   {
       GPIO_WriteLow(GN1640_PORT, GN1640_CLK_PIN);
@@ -115,10 +147,9 @@
       GPIO_WriteHigh(GN1640_PORT, GN1640_DATA_PIN);
       gn1640_delay_us(2);
 
-      /* Return PB4/PB5 to the I2C peripheral */
-      GPIO_Init(GN1640_PORT, GN1640_CLK_PIN,  GPIO_MODE_OUT_OD_HIZ_FAST);
-      GPIO_Init(GN1640_PORT, GN1640_DATA_PIN, GPIO_MODE_OUT_OD_HIZ_FAST);
-      I2C_Cmd(ENABLE);
+      if (!gn1640_bus_hold) {
+          gn1640_bus_give();
+      }
   }
 
   /* Shift out one byte, LSB first (GN1640T is not standard I2C - no ACK) */
@@ -161,11 +192,13 @@
   void GN1640_WriteFrame(uint8_t *data, uint8_t len)
   {
       uint8_t i;
+      TRACE(TRACE_TX_START);
       GN1640_Start();
       for (i = 0; i < len; i++) {
           GN1640_WriteByte(data[i]);
       }
       GN1640_Stop();
+      TRACE(TRACE_TX_END);
   }
 
   /* Single-byte command frame */
@@ -174,6 +207,16 @@
       GN1640_WriteFrame(&cmd, 1);
   }
 
+  /* Pins are taken lazily by the next START, so holding costs nothing
+   * until a frame is actually sent. Releasing gives them back at once. */
+  void GN1640_BusHold(uint8_t hold)
+  {
+      gn1640_bus_hold = hold;
+      if (!hold) {
+          gn1640_bus_give();
+      }
+  }
+
   /*============================================================================*/
   /* CORE DRIVER FUNCTIONS                                                      */
   /*============================================================================*/
@@ -181,9 +224,11 @@
   void GN1640_Init(void)
   {
       gn1640_delay_us(100);
+      GN1640_BusHold(1);                         /* one I2C hand-over for all three */
       GN1640_SendCommand(CMD_DATA_SET | 0x00);   /* Frame 1: auto address increment */
       GN1640_Clear();                            /* Frame 2: clear all grids        */
       GN1640_SetBrightness(BRIGHTNESS_MAX);      /* Frame 3: display ON, max bright */
+      GN1640_BusHold(0);
   }
 
   void GN1640_Clear(void)
@@ -195,17 +240,67 @@
       GN1640_UpdateDisplay();
   }
 
-  /* Build the address+data frame and send it in one transaction */
+  /* Send every grid, regardless of what the controller already holds */
   void GN1640_UpdateDisplay(void)
+  {
+      GN1640_UpdateRange(0, GN1640_GRIDS);
+  }
+
+  /* Build the address+data frame for a grid window of an image and send
+   * it in one transaction. Auto address increment (set in Init) walks the
+   * window. */
+  static void gn1640_send_range(const uint8_t *image, uint8_t first, uint8_t count)
   {
       uint8_t frame[GN1640_GRIDS + 1];
       uint8_t i;
 
-      frame[0] = CMD_ADDR_SET;                   /* 0xC0 - start at grid address 0 */
-      for (i = 0; i < GN1640_GRIDS; i++) {
-          frame[1 + i] = displayBuffer[i];
+      if (first >= GN1640_GRIDS || count == 0) {
+          return;
+      }
+      if (count > (uint8_t)(GN1640_GRIDS - first)) {
+          count = (uint8_t)(GN1640_GRIDS - first);
+      }
+
+      frame[0] = (uint8_t)(CMD_ADDR_SET | first);  /* 0xC0 + start grid */
+      for (i = 0; i < count; i++) {
+          frame[1 + i] = image[first + i];
+          gn1640_shadow[first + i] = image[first + i];
+      }
+      GN1640_WriteFrame(frame, (uint8_t)(count + 1));
+  }
+
+  void GN1640_UpdateRange(uint8_t first, uint8_t count)
+  {
+      gn1640_send_range(displayBuffer, first, count);
+  }
+
+  /* Send the smallest grid window covering every grid that differs from
+   * what the controller holds */
+  uint8_t GN1640_FlushImage(const uint8_t *image)
+  {
+      uint8_t first, last;
+
+      for (first = 0; first < GN1640_GRIDS; first++) {
+          if (image[first] != gn1640_shadow[first]) {
+              break;
+          }
+      }
+      if (first == GN1640_GRIDS) {
+          return 0;
+      }
+
+      last = GN1640_GRIDS - 1;
+      while (image[last] == gn1640_shadow[last]) {
+          last--;
       }
-      GN1640_WriteFrame(frame, GN1640_GRIDS + 1);
+
+      gn1640_send_range(image, first, (uint8_t)(last - first + 1));
+      return 1;
+  }
+
+  uint8_t GN1640_Flush(void)
+  {
+      return GN1640_FlushImage(displayBuffer);
   }
 
   void GN1640_SetBrightness(uint8_t brightness)
@@ -213,18 +308,31 @@
       if (brightness > BRIGHTNESS_MAX) {
           brightness = BRIGHTNESS_MAX;
       }
+      gn1640_brightness = brightness;
+      gn1640_display_on = 1;
       GN1640_SendCommand((uint8_t)(CMD_DISP_CTRL | DISP_ON | brightness));
   }
 
+  uint8_t GN1640_GetBrightness(void)
+  {
+      return gn1640_brightness;
+  }
+
   void GN1640_SetDisplayState(uint8_t state)
   {
+      gn1640_display_on = (uint8_t)(state != 0);
       if (state) {
-          GN1640_SendCommand(CMD_DISP_CTRL | DISP_ON | BRIGHTNESS_MAX);
+          GN1640_SendCommand((uint8_t)(CMD_DISP_CTRL | DISP_ON | gn1640_brightness));
       } else {
           GN1640_SendCommand(CMD_DISP_CTRL | DISP_OFF);
       }
   }
 
+  uint8_t GN1640_GetDisplayState(void)
+  {
+      return gn1640_display_on;
+  }
+
   /*============================================================================*/
   /* BUFFER MANIPULATION FUNCTIONS                                              */
   /*============================================================================*/
@@ -244,6 +352,14 @@
       return 0;
   }
 
+  uint8_t GN1640_GetShownGrid(uint8_t grid)
+  {
+      if (grid < GN1640_GRIDS) {
+          return gn1640_shadow[grid];
+      }
+      return 0;
+  }
+
   /*============================================================================*/
   /* HIGH-LEVEL DISPLAY FUNCTIONS                                               */
   /*============================================================================*/
@@ -287,7 +403,9 @@
       if (!GN1640_GetCharMask(ch, &mask)) {
           return 0;
       }
+      TRACE(TRACE_FONT);
       GN1640_SetDigitSegments(digit, mask);
+      TRACE(TRACE_BUFFER);
       return 1;
   }
 
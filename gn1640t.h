@@ -78,6 +78,20 @@
   //       5
   //
   // Segments: 1-8 outer, 9-16 inner/diagonal
+
+  // Segment groups by physical position, for wipes and bar graphs.
+  // Columns run left to right, rows bottom to top.
+  #define SEG_COL0  (SEG(7)|SEG(8))
+  #define SEG_COL1  (SEG(1)|SEG(6)|SEG(9)|SEG(15)|SEG(16))
+  #define SEG_COL2  (SEG(10)|SEG(14))
+  #define SEG_COL3  (SEG(2)|SEG(5)|SEG(11)|SEG(12)|SEG(13))
+  #define SEG_COL4  (SEG(3)|SEG(4))
+  #define SEG_ROW0  (SEG(5)|SEG(6))
+  #define SEG_ROW1  (SEG(4)|SEG(7)|SEG(13)|SEG(14)|SEG(15))
+  #define SEG_ROW2  (SEG(12)|SEG(16))
+  #define SEG_ROW3  (SEG(3)|SEG(8)|SEG(9)|SEG(10)|SEG(11))
+  #define SEG_ROW4  (SEG(1)|SEG(2))
+  #define SEG_GROUPS 5
   
   /*============================================================================*/
   /* FONT TABLE STRUCTURE                                                       */
@@ -125,18 +139,53 @@
    * @brief Update display with current buffer contents
    */
   void GN1640_UpdateDisplay(void);
+
+  /**
+   * @brief Send only the grids that changed since the last transfer
+   * @return 1 if a frame was sent, 0 if the display was already current
+   * @note Cheap to call often - does nothing when the image is unchanged
+   */
+  uint8_t GN1640_Flush(void);
+
+  /**
+   * @brief Send a window of displayBuffer grids in one frame
+   * @param first: First grid (0-15)
+   * @param count: Number of consecutive grids to send
+   */
+  void GN1640_UpdateRange(uint8_t first, uint8_t count);
+
+  /**
+   * @brief Like GN1640_Flush(), but for another 16-byte grid image
+   * @param image: Grid image to show, e.g. a pre-rendered page
+   * @return 1 if a frame was sent, 0 if the display already matched
+   * @note displayBuffer is not touched. The next GN1640_Flush() sends
+   *       displayBuffer again wherever it differs.
+   */
+  uint8_t GN1640_FlushImage(const uint8_t *image);
   
   /**
    * @brief Set display brightness
    * @param brightness: 0-7 (0=dimmest, 7=brightest)
    */
   void GN1640_SetBrightness(uint8_t brightness);
+
+  /**
+   * @brief Get the brightness last set
+   * @return 0-7
+   */
+  uint8_t GN1640_GetBrightness(void);
   
   /**
    * @brief Turn display on/off
-   * @param state: 1=on, 0=off
+   * @param state: 1=on (at the last set brightness), 0=off
    */
   void GN1640_SetDisplayState(uint8_t state);
+
+  /**
+   * @brief Get the display state last set
+   * @return 1=on, 0=off
+   */
+  uint8_t GN1640_GetDisplayState(void);
   
   /*============================================================================*/
   /* HIGH-LEVEL DISPLAY FUNCTIONS                                               */
@@ -204,6 +253,14 @@
    * @param cmd: Command byte
    */
   void GN1640_SendCommand(uint8_t cmd);
+
+  /**
+   * @brief Keep PB4/PB5 as GPIO across frames instead of per frame
+   * @param hold: 1=keep the pins after STOP, 0=return them to I2C now
+   * @note By default every frame disables I2C on START and re-enables it
+   *       on STOP. Holding batches several frames into one hand-over.
+   */
+  void GN1640_BusHold(uint8_t hold);
   
   /*============================================================================*/
   /* BUFFER MANIPULATION FUNCTIONS                                              */
@@ -222,5 +279,12 @@
    * @return Current segment mask for this grid
    */
   uint8_t GN1640_GetGrid(uint8_t grid);
+
+  /**
+   * @brief Get the grid value the controller currently holds
+   * @param grid: Grid number (0-15)
+   * @return Segment mask last sent for this grid
+   */
+  uint8_t GN1640_GetShownGrid(uint8_t grid);
   
   #endif /* __GN1640T_H */
\ No newline at end of file
@@ -1,37 +1,50 @@
 #include "stm8s.h"
 #include "gn1640t.h"
+#include "sched.h"
+#include "anim.h"
+#include "trace.h"
+
+/*
+ * All examples run on the tick scheduler (sched.c). Tasks only change
+ * displayBuffer; the scheduler flushes the changed grids afterwards and
+ * sleeps in WFI until the next tick or interrupt. Static screens need no
+ * tick at all and HALT, since the GN1640T keeps refreshing the LEDs.
+ */
+
+static uint8_t example_idx;
+static int16_t example_counter;
+static uint8_t example_hours;
+static uint8_t example_minutes;
+static uint8_t example_seconds;
 
 /**
- * @brief Simple millisecond delay
- * @param ms: Milliseconds to delay (approximate)
+ * @brief Sleep forever - the GN1640T holds the picture on its own
  */
-void DelayMs(uint16_t ms) {
-    uint16_t i, j;
-    for (i = 0; i < ms; i++) {
-        for (j = 0; j < 120; j++) {
-            nop();
-        }
+static void Idle_Halt(void) {
+    while (1) {
+        halt();
     }
 }
 
 /**
  * @brief Example 1: Display scrolling characters
  */
-void Example_ScrollCharacters(void) {
-    uint8_t idx = 0;
+static void Task_ScrollCharacters(void) {
+    GN1640_DisplayChar(0, GN1640_Font[example_idx].ch);
 
-    while (1) {
-        GN1640_Clear();
-        GN1640_DisplayChar(0, GN1640_Font[idx].ch);
-        GN1640_UpdateDisplay();
+    example_idx++;
+    if (example_idx >= GN1640_FontCount) {
+        example_idx = 0;
+    }
+}
 
-        DelayMs(500);
+void Example_ScrollCharacters(void) {
+    example_idx = 0;
 
-        idx++;
-        if (idx >= GN1640_FontCount) {
-            idx = 0;
-        }
-    }
+    GN1640_Clear();
+    Sched_Init();
+    Sched_AddTask(Task_ScrollCharacters, 500);
+    Sched_Run();
 }
 
 /**
@@ -41,67 +54,85 @@ void Example_DisplayText(void) {
     GN1640_Clear();
     GN1640_DisplayString(0, "HELLO");
 
-    while (1) {
-        /* Text stays on display */
-    }
+    Idle_Halt();
 }
 
 /**
  * @brief Example 3: Display counter
  */
-void Example_Counter(void) {
-    int16_t counter = 0;
+static void Task_Counter(void) {
+    GN1640_Clear();
+    GN1640_DisplayNumber(1, example_counter, 0);
 
-    while (1) {
-        GN1640_Clear();
-        GN1640_DisplayNumber(1, counter, 0);
+    example_counter++;
+    if (example_counter > 9999) {
+        example_counter = 0;
+    }
+}
 
-        DelayMs(100);
+void Example_Counter(void) {
+    example_counter = 0;
 
-        counter++;
-        if (counter > 9999) {
-            counter = 0;
-        }
-    }
+    GN1640_Clear();
+    Sched_Init();
+    Sched_AddTask(Task_Counter, 100);
+    Sched_Run();
 }
 
 /**
  * @brief Example 4: Display time format (HH:MM)
  */
+static void Task_Clock(void) {
+    example_seconds++;
+    if (example_seconds >= 60) {
+        example_seconds = 0;
+        example_minutes++;
+        if (example_minutes >= 60) {
+            example_minutes = 0;
+            example_hours++;
+            if (example_hours >= 24) {
+                example_hours = 0;
+            }
+        }
+    }
+
+    GN1640_DisplayChar(0, (char)('0' + (example_hours / 10)));
+    GN1640_DisplayChar(1, (char)('0' + (example_hours % 10)));
+    GN1640_DisplayChar(2, (example_seconds & 1) ? ' ' : ':');
+    GN1640_DisplayChar(3, (char)('0' + (example_minutes / 10)));
+    GN1640_DisplayChar(4, (char)('0' + (example_minutes % 10)));
+}
+
 void Example_TimeDisplay(void) {
-    uint8_t hours = 12;
-    uint8_t minutes = 34;
+    example_hours = 12;
+    example_minutes = 34;
+    example_seconds = 0;
 
     GN1640_Clear();
-    GN1640_DisplayChar(0, '0' + (hours / 10));
-    GN1640_DisplayChar(1, '0' + (hours % 10));
-    GN1640_DisplayChar(2, ':');
-    GN1640_DisplayChar(3, '0' + (minutes / 10));
-    GN1640_DisplayChar(4, '0' + (minutes % 10));
-    GN1640_UpdateDisplay();
-
-    while (1) {
-        /* Update time here */
-    }
+    Sched_Init();
+    Sched_AddTask(Task_Clock, 1000);
+    Sched_Run();
 }
 
 /**
  * @brief Example 5: Brightness control
  */
-void Example_BrightnessControl(void) {
-    uint8_t brightness = 0;
+static void Task_Brightness(void) {
+    GN1640_SetBrightness(example_idx);
 
-    GN1640_DisplayString(0, "BRIGHT");
+    example_idx++;
+    if (example_idx > BRIGHTNESS_MAX) {
+        example_idx = 0;
+    }
+}
 
-    while (1) {
-        GN1640_SetBrightness(brightness);
-        DelayMs(500);
+void Example_BrightnessControl(void) {
+    example_idx = 0;
 
-        brightness++;
-        if (brightness > BRIGHTNESS_MAX) {
-            brightness = 0;
-        }
-    }
+    GN1640_DisplayString(0, "BRIGHT");
+    Sched_Init();
+    Sched_AddTask(Task_Brightness, 500);
+    Sched_Run();
 }
 
 /**
@@ -115,38 +146,58 @@ void Example_CustomPattern(void) {
     pattern = SEG(1) | SEG(5) | SEG(9) | SEG(13);
     GN1640_SetDigitSegments(0, pattern);
 
-    GN1640_UpdateDisplay();
+    GN1640_Flush();
 
-    while (1) {
-        /* Pattern stays on display */
-    }
+    Idle_Halt();
 }
 
 /**
  * @brief Example 7: Scrolling text
  */
-void Example_ScrollingText(void) {
+static void Task_ScrollingText(void) {
     const char* text = "HELLO WORLD    ";
-    uint8_t offset = 0;
     uint8_t i;
 
-    while (1) {
-        GN1640_Clear();
+    for (i = 0; i < 6; i++) {
+        GN1640_DisplayChar(i, text[(example_idx + i) % 16]);
+    }
 
-        for (i = 0; i < 6; i++) {
-            uint8_t ch_idx;
-            ch_idx = (offset + i) % 16;
-            GN1640_DisplayChar(i, text[ch_idx]);
-        }
+    example_idx++;
+    if (example_idx >= 16) {
+        example_idx = 0;
+    }
+}
 
-        GN1640_UpdateDisplay();
-        DelayMs(300);
+void Example_ScrollingText(void) {
+    example_idx = 0;
 
-        offset++;
-        if (offset >= 16) {
-            offset = 0;
-        }
-    }
+    GN1640_Clear();
+    Sched_Init();
+    Sched_AddTask(Task_ScrollingText, 300);
+    Sched_Run();
+}
+
+/**
+ * @brief Example 9: Flash-resident animation (outer-ring spinner)
+ *
+ * Generated with: anim_encode -l -n anim_spinner spinner.txt
+ * where spinner.txt lights segments 1..8 in turn on all digits, 80 ms each:
+ *   80 3F 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00
+ *   80 00 3F 00 00 00 00 00 00 00 00 00 00 00 00 00 00
+ *   ...
+ */
+static const uint8_t anim_spinner[42] = {
+    0x08, 0x02, 0x00, 0x3F, 0x70, 0x00, 0x08, 0x01, 0x01, 0x00, 0x3F, 0x08,
+    0x01, 0x11, 0x00, 0x3F, 0x08, 0x01, 0x21, 0x00, 0x3F, 0x08, 0x01, 0x31,
+    0x00, 0x3F, 0x08, 0x01, 0x41, 0x00, 0x3F, 0x08, 0x01, 0x51, 0x00, 0x3F,
+    0x08, 0x01, 0x61, 0x00, 0x3F, 0x00,
+};
+
+void Example_Animation(void) {
+    Sched_Init();
+    Anim_Start(anim_spinner, 1);
+    Sched_AddTask(Anim_Tick, ANIM_TICK_MS);
+    Sched_Run();
 }
 
 /* ==================================================================
@@ -164,28 +215,34 @@ void Example_ScrollingText(void) {
  *
  * Keys: '0'-'9' display on screen, 'C' = clear, 'B' = backspace
  *
+ * The receiver is an event-only scheduler task: the UART1 RX ISR
+ * calls Sched_Signal(keypad_task) after storing the byte, and the
+ * core sleeps in WFI until then.
+ *
+ * Build with GN1640_TRACE defined to measure keypress-to-segment
+ * latency: add TRACE_ISR(TRACE_UART_RX) to the UART1 RX ISR, call
+ * Trace_Init() at startup and Trace_Dump(UART1_putc) on demand, then
+ * feed the dump to tools/trace_decode.
+ *
  * NOTE: This example requires your own UART1 ring buffer driver.
  *       Replace UART1_available() and UART1_getc() with your
  *       UART implementation.
  * ================================================================== */
 /*
-void Example_KeypadDisplay(void) {
-    uint8_t rx_state = 0;
-    uint8_t rx_type = 0;
-    uint8_t rx_len = 0;
-    uint8_t rx_key = 0;
-    uint8_t rx_chk = 0;
-    uint8_t digit_pos = 0;
-    uint16_t byte;
+uint8_t keypad_task = SCHED_NO_TASK;
 
-    GN1640_Clear();
-    GN1640_DisplayString(0, "READY");
+static uint8_t rx_state = 0;
+static uint8_t rx_type = 0;
+static uint8_t rx_len = 0;
+static uint8_t rx_key = 0;
+static uint8_t rx_chk = 0;
+static uint8_t digit_pos = 0;
 
-    while (1) {
-        if (!UART1_available()) {
-            continue;
-        }
+static void Task_KeypadRx(void) {
+    uint16_t byte;
+    uint8_t i;
 
+    while (UART1_available()) {
         byte = UART1_getc();
 
         switch (rx_state) {
@@ -216,19 +273,19 @@ void Example_KeypadDisplay(void) {
 
             case 4:
                 if ((uint8_t)byte == rx_chk && rx_type == 0x01) {
+                    TRACE(TRACE_PARSED);
                     if (rx_key == 'C') {
-                        GN1640_Clear();
-                        GN1640_UpdateDisplay();
+                        for (i = 0; i < GN1640_GRIDS; i++) {
+                            GN1640_SetGrid(i, 0);
+                        }
                         digit_pos = 0;
                     } else if (rx_key == 'B') {
                         if (digit_pos > 0) {
                             digit_pos--;
                             GN1640_DisplayChar(digit_pos, ' ');
-                            GN1640_UpdateDisplay();
                         }
                     } else if (digit_pos < GN1640_DIGITS) {
                         GN1640_DisplayChar(digit_pos, rx_key);
-                        GN1640_UpdateDisplay();
                         digit_pos++;
                     }
                 }
@@ -241,6 +298,15 @@ void Example_KeypadDisplay(void) {
         }
     }
 }
+
+void Example_KeypadDisplay(void) {
+    GN1640_Clear();
+    GN1640_DisplayString(0, "READY");
+
+    Sched_Init();
+    keypad_task = Sched_AddTask(Task_KeypadRx, 0);
+    Sched_Run();
+}
 */
 
 /**
@@ -277,4 +343,5 @@ void main(void) {
     /* Example_CustomPattern();     */ /* Example 6 */
     /* Example_ScrollingText();     */ /* Example 7 */
     /* Example_KeypadDisplay();     */ /* Example 8: UART Keypad -> GN1640T */
+    /* Example_Animation();         */ /* Example 9 */
 }
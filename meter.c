@@ -0,0 +1,137 @@
+/**
+  ******************************************************************************
+  * @file    meter.c
+  * @brief   Bar-graph and level-meter renderer for the 6-digit display
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  */
+
+  #include "meter.h"
+  #include "gn1640t.h"
+
+  /*============================================================================*/
+  /* PATTERN TABLES                                                             */
+  /*============================================================================*/
+
+  /* Column (SEG_COLn) and row (SEG_ROWn) of each grid, i.e. of segment
+   * grid+1. A level then only needs one compare per grid. */
+  static const uint8_t meter_col[GN1640_GRIDS] = {
+      1, 3, 4, 4, 3, 1, 0, 0, 1, 2, 3, 3, 3, 2, 1, 1
+  };
+
+  static const uint8_t meter_row[GN1640_GRIDS] = {
+      4, 4, 3, 1, 0, 0, 1, 3, 3, 3, 3, 2, 1, 1, 1, 2
+  };
+
+  /* Digit bits 0..n-1 set, n = 0..6 */
+  static const uint8_t meter_digits[GN1640_DIGITS + 1] = {
+      0x00, 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F
+  };
+
+  /*============================================================================*/
+  /* STATE                                                                      */
+  /*============================================================================*/
+
+  static uint8_t meter_mode;
+  static uint16_t meter_max = 1;
+  static uint8_t meter_hold;
+  static uint8_t meter_hold_count;
+  static uint8_t meter_level;       /* 0..30 */
+  static uint8_t meter_peak;        /* 0..30, 0 = no dot */
+
+  /*============================================================================*/
+  /* RENDERING                                                                  */
+  /*============================================================================*/
+
+  /* Grid byte for `level` (0..30) and the peak dot at `peak` (1..30) */
+  static uint8_t meter_grid(uint8_t g, uint8_t level, uint8_t peak)
+  {
+      uint8_t major, minor, pos, b;
+
+      if (meter_mode == METER_VFILL) {
+          /* Rows bottom to top, digits left to right inside a row */
+          pos = meter_row[g];
+          major = (uint8_t)(level / GN1640_DIGITS);
+          minor = (uint8_t)(level % GN1640_DIGITS);
+          if (pos < major) {
+              b = meter_digits[GN1640_DIGITS];
+          } else if (pos == major) {
+              b = meter_digits[minor];
+          } else {
+              b = 0;
+          }
+          if (peak && pos == (uint8_t)((peak - 1) / GN1640_DIGITS)) {
+              b |= (uint8_t)(1 << ((peak - 1) % GN1640_DIGITS));
+          }
+      } else {
+          /* Digits left to right, columns left to right inside a digit */
+          pos = meter_col[g];
+          major = (uint8_t)(level / SEG_GROUPS);
+          minor = (uint8_t)(level % SEG_GROUPS);
+          b = meter_digits[major];
+          if (pos < minor) {
+              b |= (uint8_t)(1 << major);
+          }
+          if (peak && pos == (uint8_t)((peak - 1) % SEG_GROUPS)) {
+              b |= (uint8_t)(1 << ((peak - 1) / SEG_GROUPS));
+          }
+      }
+      return b;
+  }
+
+  /*============================================================================*/
+  /* METER FUNCTIONS                                                            */
+  /*============================================================================*/
+
+  void Meter_Init(uint8_t mode, uint16_t max, uint8_t peak_hold)
+  {
+      uint8_t g;
+
+      meter_mode = mode;
+      meter_max = max ? max : 1;
+      meter_hold = peak_hold;
+      meter_hold_count = 0;
+      meter_level = 0;
+      meter_peak = 0;
+
+      for (g = 0; g < GN1640_GRIDS; g++) {
+          displayBuffer[g] = 0;
+      }
+  }
+
+  uint8_t Meter_Update(uint16_t value)
+  {
+      uint8_t level, peak, g;
+
+      if (value > meter_max) {
+          value = meter_max;
+      }
+      level = (uint8_t)(((uint32_t)value * METER_LEVELS) / meter_max);
+
+      /* Peak dot: jumps up at once, holds, then falls one level per sample */
+      peak = 0;
+      if (meter_hold) {
+          peak = meter_peak;
+          if (level >= peak) {
+              peak = level;
+              meter_hold_count = meter_hold;
+          } else if (meter_hold_count) {
+              meter_hold_count--;
+          } else {
+              peak--;
+          }
+      }
+
+      if (level == meter_level && peak == meter_peak) {
+          return 0;
+      }
+      meter_level = level;
+      meter_peak = peak;
+
+      for (g = 0; g < GN1640_GRIDS; g++) {
+          displayBuffer[g] = meter_grid(g, level, peak);
+      }
+      return 1;
+  }
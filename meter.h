@@ -0,0 +1,55 @@
+/**
+  ******************************************************************************
+  * @file    meter.h
+  * @brief   Bar-graph and level-meter renderer for the 6-digit display
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  * @description
+  * Maps a value in 0..max onto all 96 segment positions (6 digits x 16
+  * segments) as 30 levels:
+  * - METER_HBAR:  fills left to right, 5 segment columns per digit
+  * - METER_VFILL: fills bottom to top, 5 segment rows, each row filling
+  *                left to right across the 6 digits
+  * An optional peak-hold dot marks the highest recent level.
+  *
+  * Each sample is a table lookup per grid into displayBuffer. Nothing is
+  * sent here; the flush path then transmits only the grids that changed.
+  ******************************************************************************
+  */
+
+  #ifndef __METER_H
+  #define __METER_H
+
+  #include "stm8s.h"
+
+  /*============================================================================*/
+  /* METER PARAMETERS                                                           */
+  /*============================================================================*/
+
+  #define METER_HBAR        0     // Horizontal bar, left to right
+  #define METER_VFILL       1     // Vertical fill, bottom to top
+  #define METER_LEVELS      30    // Levels at full scale (6 digits x 5 groups)
+
+  /*============================================================================*/
+  /* METER FUNCTIONS                                                            */
+  /*============================================================================*/
+
+  /**
+   * @brief Configure the meter and clear displayBuffer
+   * @param mode: METER_HBAR or METER_VFILL
+   * @param max: Value that lights the full display (must be > 0)
+   * @param peak_hold: Samples to hold the peak dot before it decays,
+   *                   0 = no peak dot
+   */
+  void Meter_Init(uint8_t mode, uint16_t max, uint8_t peak_hold);
+
+  /**
+   * @brief Render a new sample into displayBuffer
+   * @param value: 0..max (larger values are clamped)
+   * @return 1 if displayBuffer changed, 0 if the picture is the same
+   */
+  uint8_t Meter_Update(uint16_t value);
+
+  #endif /* __METER_H */
@@ -0,0 +1,111 @@
+/**
+  ******************************************************************************
+  * @file    page.c
+  * @brief   Pre-rendered display pages with O(1) switching
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  */
+
+  #include "page.h"
+  #include "gn1640t.h"
+
+  /*============================================================================*/
+  /* STATE                                                                      */
+  /*============================================================================*/
+
+  static uint8_t page_images[PAGE_COUNT][GN1640_GRIDS];
+  static uint8_t page_dirty;              /* bit n = changed since last sent */
+  static uint8_t page_current = PAGE_NONE;
+
+  /*============================================================================*/
+  /* PAGE FUNCTIONS                                                             */
+  /*============================================================================*/
+
+  void Page_Init(void)
+  {
+      uint8_t p, g;
+
+      for (p = 0; p < PAGE_COUNT; p++) {
+          for (g = 0; g < GN1640_GRIDS; g++) {
+              page_images[p][g] = 0;
+          }
+      }
+      page_dirty = 0;
+      Page_Show(PAGE_NONE);
+  }
+
+  uint8_t *Page_Image(uint8_t page)
+  {
+      if (page < PAGE_COUNT) {
+          return page_images[page];
+      }
+      return 0;
+  }
+
+  void Page_Store(uint8_t page)
+  {
+      uint8_t g;
+      uint8_t *img;
+
+      if (page >= PAGE_COUNT) {
+          return;
+      }
+
+      img = page_images[page];
+      for (g = 0; g < GN1640_GRIDS; g++) {
+          if (img[g] != displayBuffer[g]) {
+              img[g] = displayBuffer[g];
+              page_dirty |= (uint8_t)(1 << page);
+          }
+      }
+  }
+
+  void Page_MarkDirty(uint8_t page)
+  {
+      if (page < PAGE_COUNT) {
+          page_dirty |= (uint8_t)(1 << page);
+      }
+  }
+
+  void Page_Show(uint8_t page)
+  {
+      if (page < PAGE_COUNT) {
+          page_current = page;
+      } else {
+          page_current = PAGE_NONE;
+      }
+  }
+
+  uint8_t Page_IsDirty(uint8_t page)
+  {
+      if (page < PAGE_COUNT) {
+          return (uint8_t)((page_dirty >> page) & 1);
+      }
+      return 0;
+  }
+
+  uint8_t Page_Current(void)
+  {
+      return page_current;
+  }
+
+  /* Compare the shown page on every call, not just when dirty: anything
+   * else that wrote the controller (DisplayString, Clear, animations,
+   * transitions) is undone here. The compare is 16 bytes and sends
+   * nothing when the glass already matches. */
+  uint8_t Page_Service(void)
+  {
+      if (page_current == PAGE_NONE) {
+          return GN1640_Flush();
+      }
+
+      page_dirty &= (uint8_t)~(1 << page_current);
+      return GN1640_FlushImage(page_images[page_current]);
+  }
+
+  void Page_ServiceHook(void)
+  {
+      Page_Service();
+  }
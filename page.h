@@ -0,0 +1,103 @@
+/**
+  ******************************************************************************
+  * @file    page.h
+  * @brief   Pre-rendered display pages with O(1) switching
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  * @description
+  * Keeps PAGE_COUNT 16-byte grid images in RAM. Pages are rendered and
+  * updated in the background; showing one only records which image
+  * Page_Service() flushes (GN1640_FlushImage). No font lookups or
+  * formatting happen on a switch, and the flush sends only the grids that
+  * differ from what the controller holds.
+  *
+  * Rendering a page with the normal API:
+  *   GN1640_DisplayChar(0, 'M'); ...   // draw into displayBuffer (scratch)
+  *   Page_Store(2);                    // copy into page 2
+  *
+  * While a page is shown, displayBuffer is free to use as scratch. The
+  * driver functions that send on their own (GN1640_DisplayString/
+  * DisplayNumber/Clear, animations) still send displayBuffer; the next
+  * Page_Service() puts the shown page back.
+  ******************************************************************************
+  */
+
+  #ifndef __PAGE_H
+  #define __PAGE_H
+
+  #include "stm8s.h"
+
+  /*============================================================================*/
+  /* PAGE PARAMETERS                                                            */
+  /*============================================================================*/
+
+  #define PAGE_COUNT        8     // Pages in the store (max 8, 16 bytes each)
+  #define PAGE_NONE         0xFF  // Page_Show() argument: show displayBuffer
+
+  /*============================================================================*/
+  /* PAGE FUNCTIONS                                                             */
+  /*============================================================================*/
+
+  /**
+   * @brief Clear all pages and show displayBuffer
+   */
+  void Page_Init(void);
+
+  /**
+   * @brief Get a page image for direct writes
+   * @param page: Page number (0 to PAGE_COUNT-1)
+   * @return Pointer to 16 grid bytes, or 0 if page is out of range
+   * @note Call Page_MarkDirty() after writing
+   */
+  uint8_t *Page_Image(uint8_t page);
+
+  /**
+   * @brief Copy displayBuffer into a page
+   * @param page: Page number (0 to PAGE_COUNT-1)
+   * @note Marks the page dirty only if its content changed
+   */
+  void Page_Store(uint8_t page);
+
+  /**
+   * @brief Flag a page as changed after direct writes
+   * @param page: Page number (0 to PAGE_COUNT-1)
+   */
+  void Page_MarkDirty(uint8_t page);
+
+  /**
+   * @brief Check whether a page changed since Page_Service() last sent it
+   * @param page: Page number (0 to PAGE_COUNT-1)
+   * @return 1 if changed, 0 otherwise
+   */
+  uint8_t Page_IsDirty(uint8_t page);
+
+  /**
+   * @brief Show a page - O(1), sent by the next Page_Service()
+   * @param page: Page number, or PAGE_NONE for displayBuffer
+   */
+  void Page_Show(uint8_t page);
+
+  /**
+   * @brief Get the page being shown
+   * @return Page number, or PAGE_NONE
+   */
+  uint8_t Page_Current(void);
+
+  /**
+   * @brief Send whatever of the shown page (or displayBuffer) differs from
+   *        the controller
+   * @return 1 if a frame was sent, 0 otherwise
+   * @note Fits BusArb_SetDisplayHook() directly. Updates to hidden pages
+   *       cost nothing on the bus until they are shown.
+   */
+  uint8_t Page_Service(void);
+
+  /**
+   * @brief Page_Service() without the return value
+   * @note For Sched_SetFlushHook()
+   */
+  void Page_ServiceHook(void);
+
+  #endif /* __PAGE_H */
@@ -0,0 +1,210 @@
+/**
+  ******************************************************************************
+  * @file    sched.c
+  * @brief   Tick-based main-loop scheduler with WFI idle
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  */
+
+  #include "sched.h"
+  #include "gn1640t.h"
+
+  /*============================================================================*/
+  /* TYPES AND STATE                                                            */
+  /*============================================================================*/
+
+  typedef struct {
+      sched_fn_t fn;              /* NULL = free slot                        */
+      uint16_t period;            /* ms, 0 = event-only                      */
+      uint16_t remaining;         /* ms until next run                       */
+      volatile uint8_t signalled; /* set by Sched_Signal(), maybe from ISR   */
+  } sched_task_t;
+
+  static void sched_default_flush(void);
+
+  static sched_task_t sched_tasks[SCHED_MAX_TASKS];
+  static sched_fn_t sched_flush = sched_default_flush;
+
+  /* Ticks since the main loop last looked. Only the ISR increments it and
+   * only the main loop clears it (with interrupts off). A byte is enough;
+   * it saturates at 255 ms if a task ever runs that long. */
+  static volatile uint8_t sched_ticks;
+  static volatile uint8_t sched_event;
+  static uint8_t sched_tick_on;        /* TIM4 running */
+
+  /*============================================================================*/
+  /* SCHEDULER FUNCTIONS                                                        */
+  /*============================================================================*/
+
+  static void sched_default_flush(void)
+  {
+      GN1640_Flush();
+  }
+
+  void Sched_Init(void)
+  {
+      uint8_t i;
+
+      for (i = 0; i < SCHED_MAX_TASKS; i++) {
+          sched_tasks[i].fn = 0;
+          sched_tasks[i].signalled = 0;
+      }
+      sched_ticks = 0;
+      sched_event = 0;
+
+      /* 16 MHz / 128 = 125 kHz, 125 counts = 1 ms */
+      CLK_PeripheralClockConfig(CLK_PERIPHERAL_TIMER4, ENABLE);
+      TIM4_TimeBaseInit(TIM4_PRESCALER_128, 124);
+      TIM4_ClearFlag(TIM4_FLAG_UPDATE);
+      TIM4_ITConfig(TIM4_IT_UPDATE, ENABLE);
+      TIM4_Cmd(ENABLE);
+      sched_tick_on = 1;
+
+      enableInterrupts();
+  }
+
+  /* Ticks the loop can sleep through: the nearest deadline, capped to what
+   * sched_ticks can count. With no periodic task TIM4 is stopped, so only
+   * real events (UART RX, Sched_Wake) wake the core. */
+  static uint8_t sched_next_deadline(void)
+  {
+      uint8_t i;
+      uint8_t periodic = 0;
+      uint16_t next = 0xFF;
+
+      for (i = 0; i < SCHED_MAX_TASKS; i++) {
+          if (sched_tasks[i].fn != 0 && sched_tasks[i].period != 0) {
+              periodic = 1;
+              if (sched_tasks[i].remaining < next) {
+                  next = sched_tasks[i].remaining;
+              }
+          }
+      }
+
+      if (periodic != sched_tick_on) {
+          if (periodic) {
+              TIM4_SetCounter(0);
+              TIM4_ClearFlag(TIM4_FLAG_UPDATE);
+          }
+          TIM4_Cmd(periodic ? ENABLE : DISABLE);
+          sched_tick_on = periodic;
+      }
+      return (uint8_t)next;
+  }
+
+  uint8_t Sched_AddTask(sched_fn_t fn, uint16_t period_ms)
+  {
+      uint8_t i;
+
+      for (i = 0; i < SCHED_MAX_TASKS; i++) {
+          if (sched_tasks[i].fn == 0) {
+              sched_tasks[i].period = period_ms;
+              sched_tasks[i].remaining = period_ms;
+              sched_tasks[i].signalled = 0;
+              sched_tasks[i].fn = fn;
+              return i;
+          }
+      }
+      return SCHED_NO_TASK;
+  }
+
+  void Sched_SetPeriod(uint8_t id, uint16_t period_ms)
+  {
+      if (id < SCHED_MAX_TASKS) {
+          sched_tasks[id].period = period_ms;
+          sched_tasks[id].remaining = period_ms;
+      }
+  }
+
+  void Sched_Signal(uint8_t id)
+  {
+      if (id < SCHED_MAX_TASKS) {
+          sched_tasks[id].signalled = 1;
+          sched_event = 1;
+      }
+  }
+
+  void Sched_Wake(void)
+  {
+      sched_event = 1;
+  }
+
+  void Sched_SetFlushHook(sched_fn_t fn)
+  {
+      sched_flush = fn;
+  }
+
+  void Sched_Tick(void)
+  {
+      if (sched_ticks != 0xFF) {
+          sched_ticks++;
+      }
+      TIM4_ClearITPendingBit(TIM4_IT_UPDATE);
+  }
+
+  void Sched_Run(void)
+  {
+      uint8_t elapsed;
+      uint8_t next;
+      uint8_t run;
+      uint8_t i;
+      uint16_t over;
+      sched_task_t *t;
+
+      while (1) {
+          disableInterrupts();
+          elapsed = sched_ticks;
+          sched_ticks = 0;
+          sched_event = 0;
+          enableInterrupts();
+
+          for (i = 0; i < SCHED_MAX_TASKS; i++) {
+              t = &sched_tasks[i];
+              if (t->fn == 0) {
+                  continue;
+              }
+
+              /* A signal arriving after this clear still sees the run below */
+              run = t->signalled;
+              if (run) {
+                  t->signalled = 0;
+              }
+
+              if (t->period) {
+                  if (elapsed >= t->remaining) {
+                      /* Carry the overshoot so a clock task does not drift */
+                      over = (uint16_t)(elapsed - t->remaining);
+                      t->remaining = (over < t->period) ?
+                                     (uint16_t)(t->period - over) : 1;
+                      run = 1;
+                  } else {
+                      t->remaining -= elapsed;
+                  }
+              }
+
+              if (run) {
+                  t->fn();
+              }
+          }
+
+          /* Redraws above only touched displayBuffer - push the changes */
+          if (sched_flush) {
+              sched_flush();
+          }
+
+          next = sched_next_deadline();
+
+          /* Ticks short of the next deadline go straight back to sleep
+           * without a pass. WFI sets I1/I0 itself, so nothing can slip in
+           * between the check and the sleep; the ISR returns with
+           * interrupts enabled. */
+          disableInterrupts();
+          while (sched_ticks < next && sched_event == 0) {
+              wfi();
+              disableInterrupts();
+          }
+          enableInterrupts();
+      }
+  }
@@ -0,0 +1,105 @@
+/**
+  ******************************************************************************
+  * @file    sched.h
+  * @brief   Tick-based main-loop scheduler with WFI idle
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  * @description
+  * Runs periodic display jobs (counters, clocks, scrolling) from the main
+  * loop and sleeps the core in WFI between events. The GN1640T refreshes
+  * the LEDs on its own, so between redraws the MCU has nothing to do.
+  *
+  * Hardware Configuration:
+  * - TIM4 update interrupt provides a 1 ms tick (16 MHz / 128 / 125)
+  * - Any interrupt (TIM4, UART RX, ...) wakes the core from WFI
+  *
+  * A tick only starts a loop pass when a task is due; the others return
+  * to WFI straight from the ISR wake-up. While no periodic task is
+  * registered TIM4 is stopped, and only signals and Sched_Wake() wake the
+  * loop.
+  *
+  * The TIM4 handler in stm8s_it.c must call Sched_Tick():
+  *
+  *   INTERRUPT_HANDLER(TIM4_UPD_OVF_IRQHandler, 23)
+  *   {
+  *       Sched_Tick();
+  *   }
+  ******************************************************************************
+  */
+
+  #ifndef __SCHED_H
+  #define __SCHED_H
+
+  #include "stm8s.h"
+
+  /*============================================================================*/
+  /* SCHEDULER PARAMETERS                                                       */
+  /*============================================================================*/
+
+  #define SCHED_MAX_TASKS   4     // Task table size
+  #define SCHED_NO_TASK     0xFF  // Returned by Sched_AddTask when table full
+
+  /*============================================================================*/
+  /* TYPES                                                                      */
+  /*============================================================================*/
+
+  typedef void (*sched_fn_t)(void);
+
+  /*============================================================================*/
+  /* SCHEDULER FUNCTIONS                                                        */
+  /*============================================================================*/
+
+  /**
+   * @brief Start the 1 ms TIM4 tick and clear the task table
+   * @note Enables interrupts globally
+   */
+  void Sched_Init(void);
+
+  /**
+   * @brief Register a task
+   * @param fn: Task function, runs from the main loop
+   * @param period_ms: Run period in ms, 0 = run only when signalled
+   * @return Task id, or SCHED_NO_TASK if the table is full
+   */
+  uint8_t Sched_AddTask(sched_fn_t fn, uint16_t period_ms);
+
+  /**
+   * @brief Change a task period (restarts its countdown)
+   * @param id: Task id from Sched_AddTask
+   * @param period_ms: New period in ms, 0 = run only when signalled
+   */
+  void Sched_SetPeriod(uint8_t id, uint16_t period_ms);
+
+  /**
+   * @brief Request one run of a task on the next loop pass
+   * @param id: Task id from Sched_AddTask
+   * @note Safe to call from an ISR
+   */
+  void Sched_Signal(uint8_t id);
+
+  /**
+   * @brief Keep the main loop from sleeping through the next pass
+   * @note Safe to call from an ISR that queued work for the flush hook
+   */
+  void Sched_Wake(void);
+
+  /**
+   * @brief Set the function run after the tasks on every loop pass
+   * @param fn: Flush function, default GN1640_Flush
+   */
+  void Sched_SetFlushHook(sched_fn_t fn);
+
+  /**
+   * @brief Advance the tick - call from the TIM4 update ISR
+   */
+  void Sched_Tick(void);
+
+  /**
+   * @brief Run tasks forever, sleeping in WFI between events
+   * @note Never returns
+   */
+  void Sched_Run(void);
+
+  #endif /* __SCHED_H */
@@ -0,0 +1,230 @@
+/**
+  ******************************************************************************
+  * @file    anim_encode.c
+  * @brief   Host encoder for the anim.c frame-sequence format
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  * @description
+  * Builds on the host (not the STM8):  cc -o anim_encode tools/anim_encode.c
+  *
+  * Usage: anim_encode [-l] [-n name] [input.txt] > anim_data.c
+  *   -l       Encode for looping playback (Anim_Start(stream, 1))
+  *   -n name  Array name (default anim_data)
+  *
+  * Input, one frame per line, '#' starts a comment:
+  *   <hold_ms> <grid0> <grid1> ... <grid15>
+  * Grid bytes are hex, one per GN1640T grid, as in displayBuffer.
+  *
+  * Output is a C array in the format documented in anim.h. Holds longer
+  * than 255 ticks (2.55 s) are split into extra frames with no runs.
+  ******************************************************************************
+  */
+
+  #include <stdio.h>
+  #include <stdlib.h>
+  #include <string.h>
+
+  #define GRIDS         16
+  #define MAX_FRAMES    1024
+  #define TICK_MS       10      /* must match ANIM_TICK_MS */
+  #define MAX_DELAY     255     /* ticks per stream frame */
+  #define MAX_OUT       65536
+
+  static unsigned char frames[MAX_FRAMES][GRIDS];
+  static unsigned long delays[MAX_FRAMES];   /* ticks, may exceed MAX_DELAY */
+  static int frame_count;
+
+  static unsigned char out[MAX_OUT];
+  static int out_len;
+
+  /*============================================================================*/
+  /* INPUT                                                                      */
+  /*============================================================================*/
+
+  static int parse_line(char *line, int lineno)
+  {
+      char *tok;
+      long ms;
+      int g;
+
+      tok = strchr(line, '#');
+      if (tok) {
+          *tok = '\0';
+      }
+
+      tok = strtok(line, " \t\r\n,");
+      if (!tok) {
+          return 0;                           /* blank or comment */
+      }
+      if (frame_count >= MAX_FRAMES) {
+          fprintf(stderr, "line %d: too many frames\n", lineno);
+          return -1;
+      }
+
+      ms = strtol(tok, 0, 10);
+      ms = (ms + TICK_MS / 2) / TICK_MS;      /* round to ticks */
+      if (ms < 1) {
+          ms = 1;
+      }
+      delays[frame_count] = (unsigned long)ms;
+
+      for (g = 0; g < GRIDS; g++) {
+          tok = strtok(0, " \t\r\n,");
+          if (!tok) {
+              fprintf(stderr, "line %d: expected %d grid bytes\n", lineno, GRIDS);
+              return -1;
+          }
+          frames[frame_count][g] = (unsigned char)(strtoul(tok, 0, 16) & 0x3F);
+      }
+
+      frame_count++;
+      return 0;
+  }
+
+  /*============================================================================*/
+  /* ENCODER                                                                    */
+  /*============================================================================*/
+
+  static void put(unsigned char b)
+  {
+      if (out_len >= MAX_OUT - 1) {
+          fprintf(stderr, "stream too long\n");
+          exit(1);
+      }
+      out[out_len++] = b;
+  }
+
+  /* Emit one frame: runs of grids flagged in changed[]. A single unchanged
+   * grid between two changed ones is folded into the run, since it costs
+   * the same byte as a new run header. */
+  static void encode_frame(int f, const unsigned char *changed)
+  {
+      int g, start, end, runs_at;
+      unsigned char runs = 0;
+      unsigned long hold = delays[f];
+      unsigned long chunk;
+
+      chunk = hold > MAX_DELAY ? MAX_DELAY : hold;
+      put((unsigned char)chunk);
+      hold -= chunk;
+      runs_at = out_len;
+      put(0);
+
+      g = 0;
+      while (g < GRIDS) {
+          if (!changed[g]) {
+              g++;
+              continue;
+          }
+          start = g;
+          end = g + 1;
+          while (end < GRIDS &&
+                 (changed[end] || (end + 1 < GRIDS && changed[end + 1]))) {
+              end++;
+          }
+
+          put((unsigned char)((start << 4) | (end - start - 1)));
+          for (g = start; g < end; g++) {
+              put(frames[f][g]);
+          }
+          runs++;
+      }
+
+      out[runs_at] = runs;
+
+      /* The rest of a long hold: frames that change nothing */
+      while (hold > 0) {
+          chunk = hold > MAX_DELAY ? MAX_DELAY : hold;
+          put((unsigned char)chunk);
+          put(0);
+          hold -= chunk;
+      }
+  }
+
+  static void encode(int loop)
+  {
+      unsigned char changed[GRIDS];
+      int f, g;
+
+      for (f = 0; f < frame_count; f++) {
+          for (g = 0; g < GRIDS; g++) {
+              if (f == 0) {
+                  /* Playback starts blank; a loop restarts from the last frame */
+                  changed[g] = (unsigned char)(frames[0][g] != 0 ||
+                               (loop && frames[0][g] != frames[frame_count - 1][g]));
+              } else {
+                  changed[g] = (unsigned char)(frames[f][g] != frames[f - 1][g]);
+              }
+          }
+          encode_frame(f, changed);
+      }
+      put(0);                                 /* end of stream */
+  }
+
+  /*============================================================================*/
+  /* OUTPUT                                                                     */
+  /*============================================================================*/
+
+  static void write_c(const char *name)
+  {
+      int i;
+
+      printf("/* Generated by anim_encode: %d frames, %d bytes (raw %d) */\n",
+             frame_count, out_len, frame_count * GRIDS);
+      printf("const uint8_t %s[%d] = {", name, out_len);
+      for (i = 0; i < out_len; i++) {
+          printf("%s0x%02X,", (i % 12) ? " " : "\n    ", out[i]);
+      }
+      printf("\n};\n");
+  }
+
+  int main(int argc, char **argv)
+  {
+      const char *name = "anim_data";
+      const char *path = 0;
+      FILE *in = stdin;
+      char line[512];
+      int loop = 0;
+      int lineno = 0;
+      int i;
+
+      for (i = 1; i < argc; i++) {
+          if (strcmp(argv[i], "-l") == 0) {
+              loop = 1;
+          } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+              name = argv[++i];
+          } else if (argv[i][0] == '-') {
+              fprintf(stderr, "usage: %s [-l] [-n name] [input.txt]\n", argv[0]);
+              return 2;
+          } else {
+              path = argv[i];
+          }
+      }
+
+      if (path) {
+          in = fopen(path, "r");
+          if (!in) {
+              perror(path);
+              return 1;
+          }
+      }
+
+      while (fgets(line, sizeof(line), in)) {
+          if (parse_line(line, ++lineno) < 0) {
+              return 1;
+          }
+      }
+      if (in != stdin) {
+          fclose(in);
+      }
+      if (frame_count == 0) {
+          fprintf(stderr, "no frames\n");
+          return 1;
+      }
+
+      encode(loop);
+      write_c(name);
+      return 0;
+  }
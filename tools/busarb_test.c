@@ -0,0 +1,599 @@
+/**
+  ******************************************************************************
+  * @file    busarb_test.c
+  * @brief   Host test for busarb.c against a simulated PB4/PB5 bus
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  * @description
+  * Builds on the host (not the STM8):
+  *   cc -Itools/host -I. -o busarb_test tools/busarb_test.c busarb.c gn1640t.c
+  *
+  * Usage: busarb_test       (exit status 0 = all checks passed)
+  *
+  * The SPL GPIO/I2C calls used by gn1640t.c and busarb.c are replaced by a
+  * model of the shared pins: who owns them (bit-bang GPIO or the I2C
+  * peripheral), GN1640T START/STOP conditions seen on the wire, and an I2C
+  * slave at PEER_ADDR. The slave clocks out bytes as soon as SCL is free,
+  * i.e. as if the CPU were late to every poll, and stretches SCL with BTF
+  * when both DR and the shift register are full. Every bus event goes to a
+  * log that is printed when a check fails.
+  *
+  * Checks:
+  * - No GN1640T START while an I2C transfer is open, or while the I2C
+  *   peripheral still drives the pins
+  * - I2C_Cmd() is only called when ownership actually changes
+  * - With more than BUSARB_I2C_BURST transfers queued, the display slot
+  *   still runs (and sends its frame first) on every BusArb_Poll()
+  * - Reads of 1, 2, 3 and 5 bytes clock exactly N bytes from the slave,
+  *   ACK all but the last and NACK the last
+  * - STOP and the read that follows it in a receive run with interrupts
+  *   masked, and the caller's interrupt mask is restored afterwards
+  * - Descriptors with nothing to send or receive are rejected
+  ******************************************************************************
+  */
+
+  #include <stdio.h>
+  #include <string.h>
+  #include "stm8s.h"
+  #include "gn1640t.h"
+  #include "busarb.h"
+
+  #define PEER_ADDR     0x48
+  #define PEER_BYTE(i)  ((uint8_t)(0xA0 + (i)))
+  #define LOG_LEN       4096
+
+  GPIO_TypeDef host_gpiob;
+
+  /*============================================================================*/
+  /* BUS MODEL                                                                  */
+  /*============================================================================*/
+
+  static struct {
+      /* Pin ownership */
+      uint8_t i2c_on;             /* I2C_Cmd state (enabled after reset) */
+      uint8_t pp;                 /* pins in push-pull GPIO mode, bitmask */
+      uint8_t clk, dat;           /* GPIO output levels */
+      unsigned cmd_calls;
+      unsigned cmd_redundant;
+
+      /* GN1640T side */
+      unsigned gn_starts;
+      unsigned gn_bad_starts;
+
+      /* I2C master */
+      uint8_t open;               /* START issued, STOP not yet */
+      uint8_t sb;                 /* start bit, cleared by MODE_SELECT */
+      uint8_t addressed;          /* ADDR pending */
+      uint8_t dir;
+      uint8_t ack, pos;
+      uint8_t stop_req;
+      unsigned tx_bytes;
+
+      /* I2C slave transmitter */
+      uint8_t rx_active;
+      uint8_t dr, dr_full;
+      uint8_t sr, sr_full;
+      uint8_t pos_ack;            /* POS: ACK sampled one byte early */
+      uint8_t done;               /* NACKed, or STOP ended the read */
+      unsigned sent;              /* bytes clocked out this read */
+      unsigned acked;             /* of which ACKed by the master */
+      uint8_t last_acked;
+      unsigned bad_reads;         /* ReceiveData with RXNE clear */
+
+      /* CPU */
+      uint8_t irq_on;             /* interrupts enabled */
+      unsigned unmasked;          /* receive STOP windows run unmasked */
+  } bus;
+
+  static char bus_log[LOG_LEN];
+  static unsigned log_len;
+
+  static void log_event(const char *s)
+  {
+      while (*s && log_len < LOG_LEN - 1) {
+          bus_log[log_len++] = *s++;
+      }
+      bus_log[log_len] = '\0';
+  }
+
+  static void bus_reset(void)
+  {
+      memset(&bus, 0, sizeof(bus));
+      bus.i2c_on = 1;
+      bus.clk = 1;
+      bus.dat = 1;
+      bus.ack = 1;
+      bus.irq_on = 1;             /* Sched_Init() has enabled them */
+      log_len = 0;
+      bus_log[0] = '\0';
+  }
+
+  static int i2c_owns_pins(void)
+  {
+      return bus.i2c_on && bus.pp == 0;
+  }
+
+  static int gpio_owns_pins(void)
+  {
+      return !bus.i2c_on && bus.pp == (GPIO_PIN_4 | GPIO_PIN_5);
+  }
+
+  /* Let the slave clock bytes until SCL is held (BTF) or the read ends */
+  static void bus_advance(void)
+  {
+      uint8_t ack;
+
+      while (bus.rx_active && !bus.done && !bus.sr_full) {
+          ack = bus.pos ? bus.pos_ack : bus.ack;
+          bus.pos_ack = bus.ack;
+
+          bus.sr = PEER_BYTE(bus.sent);
+          bus.sr_full = 1;
+          bus.sent++;
+          bus.last_acked = ack;
+          if (ack) {
+              bus.acked++;
+              log_event("a");
+          } else {
+              log_event("n");
+          }
+          if (!ack || bus.stop_req) {
+              bus.done = 1;
+          }
+          if (!bus.dr_full) {
+              bus.dr = bus.sr;
+              bus.dr_full = 1;
+              bus.sr_full = 0;
+          }
+      }
+  }
+
+  /*============================================================================*/
+  /* SPL STUBS                                                                  */
+  /*============================================================================*/
+
+  void host_set_irq(uint8_t on)
+  {
+      bus.irq_on = on;
+  }
+
+  uint8_t ITC_GetCPUCC(void)
+  {
+      return bus.irq_on ? 0x20 : 0x28;
+  }
+
+  void GPIO_Init(GPIO_TypeDef *port, GPIO_Pin_TypeDef pin, GPIO_Mode_TypeDef mode)
+  {
+      (void)port;
+      if (mode == GPIO_MODE_OUT_PP_HIGH_FAST) {
+          bus.pp |= pin;
+          if (pin == GPIO_PIN_4) {
+              bus.clk = 1;
+          } else {
+              bus.dat = 1;
+          }
+      } else {
+          bus.pp &= (uint8_t)~pin;
+      }
+  }
+
+  static void gpio_write(GPIO_Pin_TypeDef pins, uint8_t level)
+  {
+      if (pins & GPIO_PIN_5) {
+          if (bus.clk && bus.dat && !level) {
+              bus.gn_starts++;
+              log_event("G");
+              if (bus.open || !gpio_owns_pins()) {
+                  bus.gn_bad_starts++;
+                  log_event("!");
+              }
+          } else if (bus.clk && !bus.dat && level) {
+              log_event("g");
+          }
+          bus.dat = level;
+      }
+      if (pins & GPIO_PIN_4) {
+          bus.clk = level;
+      }
+  }
+
+  void GPIO_WriteHigh(GPIO_TypeDef *port, GPIO_Pin_TypeDef pins)
+  {
+      (void)port;
+      gpio_write(pins, 1);
+  }
+
+  void GPIO_WriteLow(GPIO_TypeDef *port, GPIO_Pin_TypeDef pins)
+  {
+      (void)port;
+      gpio_write(pins, 0);
+  }
+
+  void I2C_Cmd(FunctionalState state)
+  {
+      bus.cmd_calls++;
+      if ((state != DISABLE) == bus.i2c_on) {
+          bus.cmd_redundant++;
+          log_event("!");
+      }
+      bus.i2c_on = (uint8_t)(state != DISABLE);
+      log_event(bus.i2c_on ? "E" : "e");
+  }
+
+  void I2C_GenerateSTART(FunctionalState state)
+  {
+      (void)state;
+      log_event("S");
+      bus.open = 1;
+      bus.sb = (uint8_t)i2c_owns_pins();
+      bus.rx_active = 0;
+      bus.stop_req = 0;
+  }
+
+  void I2C_GenerateSTOP(FunctionalState state)
+  {
+      (void)state;
+      log_event("P");
+      if (bus.rx_active && bus.irq_on) {
+          bus.unmasked++;
+          log_event("!");
+      }
+      bus.open = 0;
+      bus.stop_req = 1;
+  }
+
+  void I2C_AcknowledgeConfig(I2C_Ack_TypeDef ack)
+  {
+      if (ack == I2C_ACK_NONE) {
+          bus.ack = 0;
+      } else {
+          bus.ack = 1;
+          bus.pos = (uint8_t)(ack == I2C_ACK_NEXT);
+      }
+  }
+
+  void I2C_Send7bitAddress(uint8_t addr, I2C_Direction_TypeDef dir)
+  {
+      bus.dir = (uint8_t)dir;
+      bus.addressed = (uint8_t)((addr >> 1) == PEER_ADDR);
+  }
+
+  void I2C_SendData(uint8_t data)
+  {
+      (void)data;
+      bus.tx_bytes++;
+  }
+
+  uint8_t I2C_ReceiveData(void)
+  {
+      uint8_t v = bus.dr;
+
+      if (!bus.dr_full) {
+          bus.bad_reads++;
+          log_event("!");
+      }
+      /* The read after STOP that frees the shift register */
+      if (bus.stop_req && bus.sr_full && bus.irq_on) {
+          bus.unmasked++;
+          log_event("!");
+      }
+      if (bus.sr_full) {
+          bus.dr = bus.sr;
+          bus.sr_full = 0;
+      } else {
+          bus.dr_full = 0;
+      }
+      return v;
+  }
+
+  ErrorStatus I2C_CheckEvent(I2C_Event_TypeDef event)
+  {
+      if (!i2c_owns_pins()) {
+          return ERROR;
+      }
+      switch (event) {
+      case I2C_EVENT_MASTER_MODE_SELECT:
+          if (!bus.sb) {
+              return ERROR;
+          }
+          bus.sb = 0;
+          return SUCCESS;
+
+      case I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED:
+      case I2C_EVENT_MASTER_RECEIVER_MODE_SELECTED:
+          if (!bus.addressed ||
+              bus.dir != (event == I2C_EVENT_MASTER_RECEIVER_MODE_SELECTED)) {
+              return ERROR;
+          }
+          /* Reading SR1 then SR3 clears ADDR and releases SCL */
+          bus.addressed = 0;
+          if (bus.dir == I2C_DIRECTION_RX) {
+              bus.rx_active = 1;
+              bus.dr_full = 0;
+              bus.sr_full = 0;
+              bus.done = 0;
+              bus.sent = 0;
+              bus.acked = 0;
+              bus.pos_ack = bus.ack;
+          }
+          return SUCCESS;
+
+      case I2C_EVENT_MASTER_BYTE_TRANSMITTED:
+          return SUCCESS;
+
+      case I2C_EVENT_MASTER_BYTE_RECEIVED:
+          bus_advance();
+          return bus.dr_full ? SUCCESS : ERROR;
+      }
+      return ERROR;
+  }
+
+  FlagStatus I2C_GetFlagStatus(I2C_Flag_TypeDef flag)
+  {
+      if (!i2c_owns_pins()) {
+          return RESET;
+      }
+      bus_advance();
+      if (flag == I2C_FLAG_RXNOTEMPTY) {
+          return bus.dr_full ? SET : RESET;
+      }
+      return (bus.dr_full && bus.sr_full) ? SET : RESET;
+  }
+
+  /*============================================================================*/
+  /* TEST HELPERS                                                               */
+  /*============================================================================*/
+
+  static int failures;
+
+  static void check(int ok, const char *what)
+  {
+      if (!ok) {
+          failures++;
+          printf("FAIL: %s\n  log: %s\n", what, bus_log);
+      }
+  }
+
+  static unsigned display_slots;
+
+  static uint8_t counting_flush(void)
+  {
+      display_slots++;
+      return GN1640_Flush();
+  }
+
+  static unsigned count_in(const char *s, char c)
+  {
+      unsigned n = 0;
+
+      while (*s) {
+          n += (*s++ == c);
+      }
+      return n;
+  }
+
+  static void start(void)
+  {
+      bus_reset();
+      GN1640_Init();
+      BusArb_Init();
+      log_len = 0;
+      bus_log[0] = '\0';
+      bus.cmd_calls = 0;
+  }
+
+  /*============================================================================*/
+  /* TESTS                                                                      */
+  /*============================================================================*/
+
+  /* Display-only traffic: pins are taken once and then kept */
+  static void test_display_only(void)
+  {
+      int i;
+
+      start();
+      for (i = 0; i < 5; i++) {
+          GN1640_SetGrid((uint8_t)i, 0x01);
+          BusArb_Poll();
+      }
+      check(count_in(bus_log, 'G') == 5, "display only: one frame per poll");
+      check(bus.cmd_calls == 1, "display only: I2C disabled once, not per frame");
+      check(bus.cmd_redundant == 0, "display only: no redundant I2C_Cmd");
+  }
+
+  /* I2C-only traffic: pins stay with the peripheral */
+  static void test_i2c_only(void)
+  {
+      static const uint8_t reg = 0x10;
+      busarb_xfer_t x;
+      int i;
+
+      start();
+      for (i = 0; i < 4; i++) {
+          memset(&x, 0, sizeof(x));
+          x.addr = PEER_ADDR;
+          x.tx = &reg;
+          x.tx_len = 1;
+          BusArb_SubmitI2C(&x);
+          BusArb_Poll();
+          check(x.status == BUSARB_DONE, "i2c only: write completes");
+      }
+      check(bus.cmd_calls == 0, "i2c only: no I2C_Cmd when pins never change hands");
+      check(count_in(bus_log, 'G') == 0, "i2c only: no display frames");
+  }
+
+  /* Both clients every poll: ownership changes, and I2C_Cmd with it */
+  static void test_interleaved(void)
+  {
+      static const uint8_t reg = 0x10;
+      busarb_xfer_t x;
+      int i;
+
+      start();
+      for (i = 0; i < 4; i++) {
+          memset(&x, 0, sizeof(x));
+          x.addr = PEER_ADDR;
+          x.tx = &reg;
+          x.tx_len = 1;
+          BusArb_SubmitI2C(&x);
+          GN1640_SetGrid(0, (uint8_t)(i + 1));
+          BusArb_Poll();
+          check(x.status == BUSARB_DONE, "interleaved: write completes");
+      }
+      check(bus.cmd_calls == 8, "interleaved: one disable and one enable per poll");
+      check(bus.cmd_redundant == 0, "interleaved: no redundant I2C_Cmd");
+      check(bus.gn_bad_starts == 0, "interleaved: no GN1640T START during I2C");
+      check(strcmp(bus_log, "eGgESPeGgESPeGgESPeGgESP") == 0,
+            "interleaved: frame, hand back, transfer");
+  }
+
+  /* Queue deeper than one burst: the display slot must not starve */
+  static void test_burst(void)
+  {
+      static const uint8_t reg = 0x10;
+      busarb_xfer_t x[BUSARB_QUEUE_LEN];
+      unsigned polls = 0;
+      unsigned before, g_at, s_at, i;
+
+      start();
+      BusArb_SetDisplayHook(counting_flush);
+      display_slots = 0;
+
+      for (i = 0; i < BUSARB_QUEUE_LEN; i++) {
+          memset(&x[i], 0, sizeof(x[i]));
+          x[i].addr = PEER_ADDR;
+          x[i].tx = &reg;
+          x[i].tx_len = 1;
+          check(BusArb_SubmitI2C(&x[i]), "burst: queue accepts QUEUE_LEN transfers");
+      }
+
+      while (x[BUSARB_QUEUE_LEN - 1].status == BUSARB_PENDING && polls < 10) {
+          GN1640_SetGrid((uint8_t)polls, 0x3F);
+          before = log_len;
+          BusArb_Poll();
+          polls++;
+
+          check(display_slots == polls, "burst: display slot runs on every poll");
+          g_at = (unsigned)(strchr(bus_log + before, 'G') - bus_log);
+          s_at = (unsigned)(strchr(bus_log + before, 'S') - bus_log);
+          check(strchr(bus_log + before, 'G') != 0 && g_at < s_at,
+                "burst: frame goes out before the poll's transfers");
+          check(count_in(bus_log + before, 'S') <= BUSARB_I2C_BURST,
+                "burst: at most BUSARB_I2C_BURST transfers per poll");
+      }
+      check(polls == (BUSARB_QUEUE_LEN + BUSARB_I2C_BURST - 1) / BUSARB_I2C_BURST,
+            "burst: queue drains at BUSARB_I2C_BURST per poll");
+      check(bus.gn_bad_starts == 0, "burst: no GN1640T START during I2C");
+      check(bus.cmd_redundant == 0, "burst: no redundant I2C_Cmd");
+  }
+
+  /* Register read of n bytes: slave must see ACK...ACK NACK, no extra byte.
+   * irq is the caller's interrupt state, which must survive the transfer. */
+  static void test_read(uint8_t n, uint8_t irq)
+  {
+      static const uint8_t reg = 0x20;
+      uint8_t rx[8];
+      busarb_xfer_t x;
+      char what[64];
+      uint8_t i;
+      int data_ok = 1;
+
+      start();
+      memset(&x, 0, sizeof(x));
+      memset(rx, 0, sizeof(rx));
+      x.addr = PEER_ADDR;
+      x.tx = &reg;
+      x.tx_len = 1;
+      x.rx = rx;
+      x.rx_len = n;
+      BusArb_SubmitI2C(&x);
+      GN1640_SetGrid(0, 0x2A);
+      host_set_irq(irq);
+      BusArb_Poll();
+
+      for (i = 0; i < n; i++) {
+          data_ok &= (rx[i] == PEER_BYTE(i));
+      }
+      sprintf(what, "read %u: transfer completes", n);
+      check(x.status == BUSARB_DONE, what);
+      sprintf(what, "read %u: data", n);
+      check(data_ok, what);
+      sprintf(what, "read %u: slave clocked exactly %u bytes", n, n);
+      check(bus.sent == n, what);
+      sprintf(what, "read %u: all but the last byte ACKed", n);
+      check(bus.acked == (unsigned)(n - 1) && !bus.last_acked, what);
+      sprintf(what, "read %u: nothing left in DR", n);
+      check(!bus.dr_full && !bus.sr_full && bus.bad_reads == 0, what);
+      sprintf(what, "read %u: STOP window runs masked", n);
+      check(bus.unmasked == 0, what);
+      sprintf(what, "read %u: caller's interrupt mask restored", n);
+      check(bus.irq_on == irq, what);
+      sprintf(what, "read %u: ACK restored, POS cleared", n);
+      check(bus.ack && !bus.pos, what);
+      check(bus.gn_bad_starts == 0, "read: no GN1640T START during I2C");
+  }
+
+  /* Nothing to send or receive: there is no START to pair with a STOP */
+  static void test_empty(void)
+  {
+      busarb_xfer_t x;
+
+      start();
+      memset(&x, 0, sizeof(x));
+      x.addr = PEER_ADDR;
+      check(!BusArb_SubmitI2C(&x), "empty: descriptor rejected");
+      check(x.status == BUSARB_IDLE, "empty: status untouched");
+      BusArb_Poll();
+      check(count_in(bus_log, 'P') == 0, "empty: no STOP on the bus");
+  }
+
+  /* A slave that never answers times out without wedging the arbiter */
+  static void test_no_slave(void)
+  {
+      static const uint8_t reg = 0x00;
+      busarb_xfer_t x;
+
+      start();
+      memset(&x, 0, sizeof(x));
+      x.addr = PEER_ADDR + 1;
+      x.tx = &reg;
+      x.tx_len = 1;
+      BusArb_SubmitI2C(&x);
+      BusArb_Poll();
+      check(x.status == BUSARB_ERROR, "no slave: transfer reports an error");
+      check(!bus.open, "no slave: STOP issued after the failure");
+
+      GN1640_SetGrid(1, 0x15);
+      BusArb_Poll();
+      check(count_in(bus_log, 'G') == 1 && bus.gn_bad_starts == 0,
+            "no slave: display still updates afterwards");
+  }
+
+  /*============================================================================*/
+  /* MAIN                                                                       */
+  /*============================================================================*/
+
+  int main(void)
+  {
+      test_display_only();
+      test_i2c_only();
+      test_interleaved();
+      test_burst();
+      test_read(1, 1);
+      test_read(2, 1);
+      test_read(3, 1);
+      test_read(5, 1);
+      test_read(1, 0);
+      test_read(3, 0);
+      test_empty();
+      test_no_slave();
+
+      if (failures) {
+          printf("%d check(s) failed\n", failures);
+          return 1;
+      }
+      printf("busarb_test: all checks passed\n");
+      return 0;
+  }
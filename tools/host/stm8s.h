@@ -0,0 +1,95 @@
+/**
+  ******************************************************************************
+  * @file    stm8s.h
+  * @brief   Host stand-in for the SPL header, for building driver sources
+  *          into host tools (see tools/busarb_test.c)
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  * @description
+  * Declares only what gn1640t.c and busarb.c use, including the CPU
+  * interrupt mask. The tool that includes the driver sources provides the
+  * function bodies. Put this directory first on the include path:
+  *   cc -Itools/host ...
+  ******************************************************************************
+  */
+
+  #ifndef __STM8S_H
+  #define __STM8S_H
+
+  #include <stdint.h>
+
+  typedef enum { DISABLE = 0, ENABLE = !DISABLE } FunctionalState;
+  typedef enum { RESET = 0, SET = !RESET } FlagStatus;
+  typedef enum { ERROR = 0, SUCCESS = !ERROR } ErrorStatus;
+
+  /*============================================================================*/
+  /* GPIO                                                                       */
+  /*============================================================================*/
+
+  typedef int GPIO_TypeDef;
+  typedef enum {
+      GPIO_PIN_4 = 0x10,
+      GPIO_PIN_5 = 0x20
+  } GPIO_Pin_TypeDef;
+  typedef enum {
+      GPIO_MODE_OUT_OD_HIZ_FAST = 0xB0,
+      GPIO_MODE_OUT_PP_HIGH_FAST = 0xF0
+  } GPIO_Mode_TypeDef;
+
+  extern GPIO_TypeDef host_gpiob;
+  #define GPIOB (&host_gpiob)
+
+  void GPIO_Init(GPIO_TypeDef *port, GPIO_Pin_TypeDef pin, GPIO_Mode_TypeDef mode);
+  void GPIO_WriteHigh(GPIO_TypeDef *port, GPIO_Pin_TypeDef pins);
+  void GPIO_WriteLow(GPIO_TypeDef *port, GPIO_Pin_TypeDef pins);
+
+  /*============================================================================*/
+  /* I2C                                                                        */
+  /*============================================================================*/
+
+  typedef enum {
+      I2C_DIRECTION_TX = 0x00,
+      I2C_DIRECTION_RX = 0x01
+  } I2C_Direction_TypeDef;
+  typedef enum {
+      I2C_ACK_NONE = 0x00,      /* ACK cleared, POS unchanged */
+      I2C_ACK_CURR = 0x01,      /* ACK set, POS cleared */
+      I2C_ACK_NEXT = 0x02       /* ACK set, POS set */
+  } I2C_Ack_TypeDef;
+  typedef enum {
+      I2C_EVENT_MASTER_MODE_SELECT               = 0x0301,
+      I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED = 0x0782,
+      I2C_EVENT_MASTER_RECEIVER_MODE_SELECTED    = 0x0302,
+      I2C_EVENT_MASTER_BYTE_RECEIVED             = 0x0340,
+      I2C_EVENT_MASTER_BYTE_TRANSMITTED          = 0x0784
+  } I2C_Event_TypeDef;
+  typedef enum {
+      I2C_FLAG_TRANSFERFINISHED = 0x0104,
+      I2C_FLAG_RXNOTEMPTY       = 0x0140
+  } I2C_Flag_TypeDef;
+
+  void I2C_Cmd(FunctionalState state);
+  void I2C_GenerateSTART(FunctionalState state);
+  void I2C_GenerateSTOP(FunctionalState state);
+  void I2C_AcknowledgeConfig(I2C_Ack_TypeDef ack);
+  void I2C_Send7bitAddress(uint8_t addr, I2C_Direction_TypeDef dir);
+  void I2C_SendData(uint8_t data);
+  uint8_t I2C_ReceiveData(void);
+  ErrorStatus I2C_CheckEvent(I2C_Event_TypeDef event);
+  FlagStatus I2C_GetFlagStatus(I2C_Flag_TypeDef flag);
+
+  /*============================================================================*/
+  /* CORE                                                                       */
+  /*============================================================================*/
+
+  /* The interrupt mask is modelled by the tool: CC reads back I1/I0 */
+  void host_set_irq(uint8_t on);
+  uint8_t ITC_GetCPUCC(void);
+
+  #define nop()
+  #define enableInterrupts()   host_set_irq(1)
+  #define disableInterrupts()  host_set_irq(0)
+
+  #endif /* __STM8S_H */
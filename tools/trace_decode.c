@@ -0,0 +1,229 @@
+/**
+  ******************************************************************************
+  * @file    trace_decode.c
+  * @brief   Host decoder for Trace_Dump() output - per-stage latency
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  * @description
+  * Builds on the host (not the STM8):  cc -o trace_decode tools/trace_decode.c
+  *
+  * Usage: trace_decode [dump.txt]     (reads stdin by default)
+  *
+  * Input is one or more Trace_Dump() captures from the serial port. Other
+  * lines are ignored, so a raw terminal log works. Each accepted packet
+  * (TRACE_PARSED) is followed through font lookup, buffer update and the
+  * next complete frame transmit. Its latency is measured back to its first
+  * UART byte: the first TRACE_UART_RX after the previous packet (or after
+  * the capture start). First byte -> last byte is reported as the UART
+  * receive stage.
+  *
+  * Timestamps are 16-bit microseconds, so each stage must finish within
+  * 65 ms to be measured correctly.
+  ******************************************************************************
+  */
+
+  #include <stdio.h>
+  #include <string.h>
+
+  /* Must match trace.h */
+  #define TRACE_UART_RX     0
+  #define TRACE_PARSED      1
+  #define TRACE_FONT        2
+  #define TRACE_BUFFER      3
+  #define TRACE_TX_START    4
+  #define TRACE_TX_END      5
+  #define TRACE_STAGES      6
+
+  #define STAT_TOTAL        0                 /* first rx byte -> tx end */
+  #define STAT_RECEIVE      TRACE_STAGES      /* first rx byte -> last */
+  #define STATS             (TRACE_STAGES + 1)
+
+  #define BUCKETS           17      /* <1us, <2us, <4us ... <65536us */
+
+  typedef struct {
+      unsigned long count;
+      unsigned long sum;
+      unsigned long min;
+      unsigned long max;
+      unsigned long hist[BUCKETS];
+  } stat_t;
+
+  /* stats[s] = time from the previous stage to stage s, plus the total
+   * and the UART receive stage */
+  static stat_t stats[STATS];
+
+  static const char *stat_names[STATS] = {
+      "total (first rx -> tx end)",
+      "last rx -> parsed",
+      "parsed -> font",
+      "font -> buffer",
+      "buffer -> tx start",
+      "tx start -> tx end",
+      "uart receive (first rx -> last rx)",
+  };
+
+  /*============================================================================*/
+  /* STATISTICS                                                                 */
+  /*============================================================================*/
+
+  static void stat_add(stat_t *st, unsigned long us)
+  {
+      int b = 0;
+
+      while (b < BUCKETS - 1 && us >= (1UL << b)) {
+          b++;
+      }
+      st->hist[b]++;
+      if (st->count == 0 || us < st->min) {
+          st->min = us;
+      }
+      if (us > st->max) {
+          st->max = us;
+      }
+      st->sum += us;
+      st->count++;
+  }
+
+  static void stat_print(int s)
+  {
+      const stat_t *st = &stats[s];
+      unsigned long peak = 0;
+      int b, bar, i;
+
+      printf("%s: n=%lu", stat_names[s], st->count);
+      if (st->count == 0) {
+          printf("\n\n");
+          return;
+      }
+      printf(" min=%luus avg=%luus max=%luus\n",
+             st->min, st->sum / st->count, st->max);
+
+      for (b = 0; b < BUCKETS; b++) {
+          if (st->hist[b] > peak) {
+              peak = st->hist[b];
+          }
+      }
+      for (b = 0; b < BUCKETS; b++) {
+          if (st->hist[b] == 0) {
+              continue;
+          }
+          bar = (int)((st->hist[b] * 40 + peak - 1) / peak);
+          printf("  < %6luus %6lu ", 1UL << b, st->hist[b]);
+          for (i = 0; i < bar; i++) {
+              putchar('#');
+          }
+          putchar('\n');
+      }
+      putchar('\n');
+  }
+
+  /*============================================================================*/
+  /* CHAIN TRACKING                                                             */
+  /*============================================================================*/
+
+  /* Stage reached so far for the packet being followed, -1 = none */
+  static int chain_stage = -1;
+  static unsigned int chain_ts[TRACE_STAGES];
+  static unsigned int chain_first_rx;
+
+  /* UART bytes of the packet being received */
+  static int have_rx;
+  static unsigned int first_rx;
+  static unsigned int last_rx;
+
+  static unsigned long elapsed(unsigned int from, unsigned int to)
+  {
+      return (unsigned long)((to - from) & 0xFFFF);
+  }
+
+  static void chain_reset(void)
+  {
+      chain_stage = -1;
+      have_rx = 0;
+  }
+
+  static void event(int stage, unsigned int ts)
+  {
+      int s;
+
+      if (stage == TRACE_UART_RX) {
+          if (!have_rx) {
+              have_rx = 1;
+              first_rx = ts;
+          }
+          last_rx = ts;
+          return;
+      }
+
+      if (stage == TRACE_PARSED) {
+          if (!have_rx) {
+              chain_stage = -1;
+              return;
+          }
+          chain_first_rx = first_rx;
+          chain_ts[TRACE_UART_RX] = last_rx;
+          chain_ts[TRACE_PARSED] = ts;
+          chain_stage = TRACE_PARSED;
+          have_rx = 0;                        /* next byte starts a packet */
+          return;
+      }
+
+      /* Only the next stage in order advances the chain */
+      if (chain_stage < 0 || stage != chain_stage + 1) {
+          return;
+      }
+      chain_ts[stage] = ts;
+      chain_stage = stage;
+
+      if (stage == TRACE_TX_END) {
+          for (s = TRACE_PARSED; s <= TRACE_TX_END; s++) {
+              stat_add(&stats[s], elapsed(chain_ts[s - 1], chain_ts[s]));
+          }
+          stat_add(&stats[STAT_RECEIVE],
+                   elapsed(chain_first_rx, chain_ts[TRACE_UART_RX]));
+          stat_add(&stats[STAT_TOTAL], elapsed(chain_first_rx, ts));
+          chain_stage = -1;
+      }
+  }
+
+  /*============================================================================*/
+  /* MAIN                                                                       */
+  /*============================================================================*/
+
+  int main(int argc, char **argv)
+  {
+      FILE *in = stdin;
+      char line[128];
+      unsigned int stage, ts;
+      int s;
+
+      if (argc > 1) {
+          in = fopen(argv[1], "r");
+          if (!in) {
+              perror(argv[1]);
+              return 1;
+          }
+      }
+
+      while (fgets(line, sizeof(line), in)) {
+          if (strncmp(line, "TRACE", 5) == 0) {
+              chain_reset();                  /* new capture */
+              continue;
+          }
+          if (sscanf(line, "%1x,%4x", &stage, &ts) == 2 && stage < TRACE_STAGES) {
+              event((int)stage, ts);
+          }
+      }
+      if (in != stdin) {
+          fclose(in);
+      }
+
+      stat_print(STAT_RECEIVE);
+      for (s = 1; s < TRACE_STAGES; s++) {
+          stat_print(s);
+      }
+      stat_print(STAT_TOTAL);
+      return 0;
+  }
@@ -0,0 +1,126 @@
+/**
+  ******************************************************************************
+  * @file    trace.c
+  * @brief   Optional input-to-display latency tracing
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  */
+
+  #include "trace.h"
+
+  #ifdef GN1640_TRACE
+
+  #define TRACE_CC_I1I0     0x28  /* CC interrupt mask bits, both set = masked */
+
+  /*============================================================================*/
+  /* STATE                                                                      */
+  /*============================================================================*/
+
+  typedef struct {
+      uint8_t stage;
+      uint16_t ts;          /* TIM2 counter, 1 us per count */
+  } trace_entry_t;
+
+  static trace_entry_t trace_ring[TRACE_LEN];
+  static uint8_t trace_head;            /* next slot, free-running */
+  static uint8_t trace_count;           /* valid entries, max TRACE_LEN */
+  static volatile uint8_t trace_on;
+
+  /*============================================================================*/
+  /* RECORDING                                                                  */
+  /*============================================================================*/
+
+  static void trace_record(uint8_t stage)
+  {
+      trace_entry_t *e = &trace_ring[trace_head & (TRACE_LEN - 1)];
+
+      e->ts = TIM2_GetCounter();
+      e->stage = stage;
+      trace_head++;
+      if (trace_count < TRACE_LEN) {
+          trace_count++;
+      }
+  }
+
+  void Trace_Init(void)
+  {
+      trace_on = 0;
+      trace_head = 0;
+      trace_count = 0;
+
+      /* 16 MHz / 16 = 1 MHz, full 16-bit range */
+      CLK_PeripheralClockConfig(CLK_PERIPHERAL_TIMER2, ENABLE);
+      TIM2_TimeBaseInit(TIM2_PRESCALER_16, 0xFFFF);
+      TIM2_Cmd(ENABLE);
+
+      trace_on = 1;
+  }
+
+  /* Restores the caller's interrupt mask, so init code and critical
+   * sections that run masked stay masked. Kept in a variable rather than
+   * push cc/pop cc: locals are SP-relative, so the stack must not move. */
+  void Trace_Point(uint8_t stage)
+  {
+      uint8_t cc;
+
+      if (!trace_on) {
+          return;
+      }
+      cc = ITC_GetCPUCC();
+      disableInterrupts();
+      trace_record(stage);
+      if ((cc & TRACE_CC_I1I0) != TRACE_CC_I1I0) {
+          enableInterrupts();
+      }
+  }
+
+  void Trace_PointISR(uint8_t stage)
+  {
+      if (trace_on) {
+          trace_record(stage);
+      }
+  }
+
+  /*============================================================================*/
+  /* DUMP                                                                       */
+  /*============================================================================*/
+
+  static void trace_hex(trace_putc_t out, uint16_t v, uint8_t digits)
+  {
+      uint8_t nib;
+
+      while (digits--) {
+          nib = (uint8_t)((v >> (digits * 4)) & 0x0F);
+          out((char)(nib < 10 ? '0' + nib : 'A' + nib - 10));
+      }
+  }
+
+  void Trace_Dump(trace_putc_t out)
+  {
+      uint8_t n, i;
+      trace_entry_t *e;
+
+      trace_on = 0;       /* freeze the ring while printing */
+
+      n = trace_count;
+
+      out('T'); out('R'); out('A'); out('C'); out('E'); out(' ');
+      trace_hex(out, n, 2);
+      out('\r'); out('\n');
+
+      for (i = 0; i < n; i++) {
+          e = &trace_ring[(uint8_t)(trace_head - n + i) & (TRACE_LEN - 1)];
+          trace_hex(out, e->stage, 1);
+          out(',');
+          trace_hex(out, e->ts, 4);
+          out('\r'); out('\n');
+      }
+
+      trace_head = 0;
+      trace_count = 0;
+      trace_on = 1;
+  }
+
+  #endif /* GN1640_TRACE */
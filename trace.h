@@ -0,0 +1,98 @@
+/**
+  ******************************************************************************
+  * @file    trace.h
+  * @brief   Optional input-to-display latency tracing
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  * @description
+  * Timestamps each stage from UART receive to lit segments into a small
+  * ring buffer. Trace_Dump() prints the ring, and tools/trace_decode.c
+  * turns the dump into per-stage latency histograms.
+  *
+  * Enabled only when GN1640_TRACE is defined project-wide (COSMIC:
+  * -dGN1640_TRACE). Otherwise the TRACE macros expand to nothing and
+  * trace.c compiles to an empty unit.
+  *
+  * Hardware Configuration:
+  * - TIM2 free-running at 1 MHz (16 MHz / 16), wraps every 65.536 ms
+  *
+  * Trace points:
+  * - TRACE_UART_RX   your UART1 RX ISR, per byte: TRACE_ISR(TRACE_UART_RX)
+  * - TRACE_PARSED    packet accepted by the receiver (Example 8)
+  * - TRACE_FONT      GN1640_DisplayChar(), font lookup done
+  * - TRACE_BUFFER    GN1640_DisplayChar(), displayBuffer updated
+  * - TRACE_TX_START  GN1640_WriteFrame(), before START
+  * - TRACE_TX_END    GN1640_WriteFrame(), after STOP
+  ******************************************************************************
+  */
+
+  #ifndef __TRACE_H
+  #define __TRACE_H
+
+  #include "stm8s.h"
+
+  /*============================================================================*/
+  /* TRACE STAGES                                                               */
+  /*============================================================================*/
+
+  #define TRACE_UART_RX     0
+  #define TRACE_PARSED      1
+  #define TRACE_FONT        2
+  #define TRACE_BUFFER      3
+  #define TRACE_TX_START    4
+  #define TRACE_TX_END      5
+
+  #define TRACE_LEN         32    // Ring entries, 3 bytes each (power of 2)
+
+  /*============================================================================*/
+  /* TRACE MACROS                                                               */
+  /*============================================================================*/
+
+  #ifdef GN1640_TRACE
+  #define TRACE(stage)      Trace_Point(stage)
+  #define TRACE_ISR(stage)  Trace_PointISR(stage)
+  #else
+  #define TRACE(stage)
+  #define TRACE_ISR(stage)
+  #endif
+
+  #ifdef GN1640_TRACE
+
+  typedef void (*trace_putc_t)(char c);
+
+  /*============================================================================*/
+  /* TRACE FUNCTIONS                                                            */
+  /*============================================================================*/
+
+  /**
+   * @brief Start the TIM2 timestamp counter and clear the ring
+   */
+  void Trace_Init(void);
+
+  /**
+   * @brief Record a stage from the main loop
+   * @param stage: TRACE_xxx
+   * @note Masks interrupts briefly and leaves them as it found them -
+   *       use Trace_PointISR() inside an ISR
+   */
+  void Trace_Point(uint8_t stage);
+
+  /**
+   * @brief Record a stage from an ISR
+   * @param stage: TRACE_xxx
+   */
+  void Trace_PointISR(uint8_t stage);
+
+  /**
+   * @brief Print the ring oldest-first and clear it
+   * @param out: Character output, e.g. a UART putc
+   * @note Output: "TRACE <n>" then one "<stage>,<usec>" line per entry,
+   *       all numbers in hex
+   */
+  void Trace_Dump(trace_putc_t out);
+
+  #endif /* GN1640_TRACE */
+
+  #endif /* __TRACE_H */
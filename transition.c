@@ -0,0 +1,225 @@
+/**
+  ******************************************************************************
+  * @file    transition.c
+  * @brief   Segment transition effects (wipe, morph, dissolve, fade)
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  */
+
+  #include "transition.h"
+  #include "gn1640t.h"
+
+  /*============================================================================*/
+  /* CONSTANTS AND STATE                                                        */
+  /*============================================================================*/
+
+  #define TRANS_POSITIONS   (GN1640_GRIDS * GN1640_DIGITS)   /* 96 */
+  #define TRANS_COLUMNS     (GN1640_DIGITS * SEG_GROUPS)     /* 30 */
+
+  #define TRANS_SEL_ALL     0   /* flip every changed segment          */
+  #define TRANS_SEL_OFF     1   /* only segments lit in the old image  */
+  #define TRANS_SEL_ON      2   /* only segments lit in the new image  */
+
+  /* Segments left of the wipe edge inside the partially revealed digit */
+  static const uint16_t trans_wipe_cols[SEG_GROUPS] = {
+      0,
+      SEG_COL0,
+      SEG_COL0 | SEG_COL1,
+      SEG_COL0 | SEG_COL1 | SEG_COL2,
+      SEG_COL0 | SEG_COL1 | SEG_COL2 | SEG_COL3,
+  };
+
+  /* Computed once per transition: new image = trans_from ^ trans_diff */
+  static uint8_t trans_from[GN1640_GRIDS];
+  static uint8_t trans_diff[GN1640_GRIDS];
+
+  static uint8_t trans_type;
+  static uint8_t trans_steps;       /* 0 = idle */
+  static uint8_t trans_step;
+  static uint8_t trans_lfsr;        /* dissolve order generator */
+  static uint8_t trans_emitted;     /* positions visited this phase */
+  static uint8_t trans_shown_level; /* ramp level last sent, 0xFF = unknown */
+
+  /*============================================================================*/
+  /* EFFECTS                                                                    */
+  /*============================================================================*/
+
+  static void trans_apply_all(void)
+  {
+      uint8_t g;
+
+      for (g = 0; g < GN1640_GRIDS; g++) {
+          displayBuffer[g] = (uint8_t)(trans_from[g] ^ trans_diff[g]);
+      }
+  }
+
+  /* Reveal the new image up to column edge (0..30) */
+  static void trans_wipe(uint8_t edge)
+  {
+      uint8_t full = (uint8_t)((1 << (edge / SEG_GROUPS)) - 1);
+      uint8_t digit = (uint8_t)(edge / SEG_GROUPS);
+      uint16_t part = trans_wipe_cols[edge % SEG_GROUPS];
+      uint8_t g, m;
+
+      for (g = 0; g < GN1640_GRIDS; g++) {
+          m = full;
+          if (digit < GN1640_DIGITS && (part & (1U << g))) {
+              m |= (uint8_t)(1 << digit);
+          }
+          displayBuffer[g] = (uint8_t)(trans_from[g] ^ (trans_diff[g] & m));
+      }
+  }
+
+  static void trans_phase_reset(void)
+  {
+      trans_lfsr = 1;
+      trans_emitted = 0;
+  }
+
+  /* Visit positions in scattered order until `count` of the 96 are done.
+   * A 7-bit maximal LFSR (x^7 + x^6 + 1) hits every value 1..127 once,
+   * so skipping values above 96 gives a permutation without a table. */
+  static void trans_dissolve(uint8_t count, uint8_t sel)
+  {
+      uint8_t pos, g, m, lsb;
+
+      while (trans_emitted < count) {
+          do {
+              lsb = (uint8_t)(trans_lfsr & 1);
+              trans_lfsr >>= 1;
+              if (lsb) {
+                  trans_lfsr ^= 0x60;
+              }
+          } while (trans_lfsr > TRANS_POSITIONS);
+
+          pos = (uint8_t)(trans_lfsr - 1);
+          g = (uint8_t)(pos / GN1640_DIGITS);
+          m = (uint8_t)(trans_diff[g] & (1 << (pos % GN1640_DIGITS)));
+          if (sel == TRANS_SEL_OFF) {
+              m &= trans_from[g];
+          } else if (sel == TRANS_SEL_ON) {
+              m &= (uint8_t)~trans_from[g];
+          }
+          displayBuffer[g] ^= m;
+          trans_emitted++;
+      }
+  }
+
+  /* Ramp levels go out as raw display-control commands, so the brightness
+   * kept by GN1640_SetBrightness() stays the level to return to. A display
+   * switched off with GN1640_SetDisplayState(0) is left off. */
+  static void trans_send_level(uint8_t level)
+  {
+      if (!GN1640_GetDisplayState()) {
+          trans_shown_level = 0xFF;
+          return;
+      }
+      if (level != trans_shown_level) {
+          GN1640_SendCommand((uint8_t)(CMD_DISP_CTRL | DISP_ON | level));
+          trans_shown_level = level;
+      }
+  }
+
+  /* Scale n/d of the way through 0..range */
+  static uint8_t trans_scale(uint8_t n, uint8_t d, uint8_t range)
+  {
+      return (uint8_t)(((uint16_t)n * range) / d);
+  }
+
+  /*============================================================================*/
+  /* TRANSITION FUNCTIONS                                                       */
+  /*============================================================================*/
+
+  void Trans_Start(uint8_t type, uint8_t steps)
+  {
+      uint8_t g;
+
+      /* An interrupted ramp may have left the display dimmed */
+      if (trans_steps != 0 && (trans_type & TRANS_RAMP)) {
+          trans_send_level(GN1640_GetBrightness());
+      }
+
+      for (g = 0; g < GN1640_GRIDS; g++) {
+          trans_from[g] = GN1640_GetShownGrid(g);
+          trans_diff[g] = (uint8_t)(trans_from[g] ^ displayBuffer[g]);
+          displayBuffer[g] = trans_from[g];
+      }
+
+      trans_type = type;
+      trans_steps = steps ? steps : 1;
+      trans_step = 0;
+      trans_shown_level = GN1640_GetBrightness();
+      trans_phase_reset();
+  }
+
+  uint8_t Trans_Step(void)
+  {
+      uint8_t half, level;
+      int16_t dist;
+
+      if (trans_steps == 0) {
+          return 0;
+      }
+      trans_step++;
+
+      switch (trans_type & 0x7F) {
+          case TRANS_WIPE:
+              trans_wipe(trans_scale(trans_step, trans_steps, TRANS_COLUMNS));
+              break;
+
+          case TRANS_MORPH:
+              half = (uint8_t)((trans_steps + 1) / 2);
+              if (trans_step <= half) {
+                  trans_dissolve(trans_scale(trans_step, half, TRANS_POSITIONS),
+                                 TRANS_SEL_OFF);
+              } else {
+                  if (trans_step == half + 1) {
+                      trans_phase_reset();
+                  }
+                  trans_dissolve(trans_scale((uint8_t)(trans_step - half),
+                                             (uint8_t)(trans_steps - half),
+                                             TRANS_POSITIONS),
+                                 TRANS_SEL_ON);
+              }
+              break;
+
+          case TRANS_DISSOLVE:
+              trans_dissolve(trans_scale(trans_step, trans_steps, TRANS_POSITIONS),
+                             TRANS_SEL_ALL);
+              break;
+
+          default:   /* TRANS_CUT */
+              if ((uint16_t)trans_step * 2 >= trans_steps) {
+                  trans_apply_all();
+              }
+              break;
+      }
+
+      /* V-shaped ramp: full at both ends, dimmest at the midpoint. Scaled
+       * from the current brightness, so a change made mid-way is kept. */
+      if (trans_type & TRANS_RAMP) {
+          dist = (int16_t)(2 * trans_step) - trans_steps;
+          if (dist < 0) {
+              dist = -dist;
+          }
+          level = (uint8_t)(((uint16_t)dist * GN1640_GetBrightness()) / trans_steps);
+          if (trans_step >= trans_steps) {
+              trans_shown_level = 0xFF;   /* always land on the stored level */
+          }
+          trans_send_level(level);
+      }
+
+      if (trans_step >= trans_steps) {
+          trans_apply_all();           /* land exactly on the new image */
+          trans_steps = 0;
+          return 0;
+      }
+      return 1;
+  }
+
+  uint8_t Trans_Busy(void)
+  {
+      return (uint8_t)(trans_steps != 0);
+  }
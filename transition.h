@@ -0,0 +1,63 @@
+/**
+  ******************************************************************************
+  * @file    transition.h
+  * @brief   Segment transition effects (wipe, morph, dissolve, fade)
+  * @author  STM8 GN1640T Driver
+  * @version 1.0.0
+  * @date    2026
+  ******************************************************************************
+  * @description
+  * Animates the change from the picture the GN1640T currently shows to the
+  * one rendered in displayBuffer. Trans_Start() computes the old image and
+  * the changed-segment masks once. Each Trans_Step() then only flips the
+  * segments that belong to that step, so the flush path sends just the
+  * grids that changed.
+  *
+  * Usage:
+  *   GN1640_DisplayChar(...);               // render the new screen, no flush
+  *   Trans_Start(TRANS_DISSOLVE | TRANS_RAMP, 12);
+  *   ...then call Trans_Step() from a periodic task until it returns 0
+  ******************************************************************************
+  */
+
+  #ifndef __TRANSITION_H
+  #define __TRANSITION_H
+
+  #include "stm8s.h"
+
+  /*============================================================================*/
+  /* TRANSITION TYPES                                                           */
+  /*============================================================================*/
+
+  #define TRANS_CUT         0x00  // Swap at the halfway step
+  #define TRANS_WIPE        0x01  // Reveal left to right, 5 columns per digit
+  #define TRANS_MORPH       0x02  // Old-only segments go out, then new ones in
+  #define TRANS_DISSOLVE    0x03  // Changed segments flip in scattered order
+  #define TRANS_RAMP        0x80  // OR in: dip to minimum brightness mid-way
+
+  /*============================================================================*/
+  /* TRANSITION FUNCTIONS                                                       */
+  /*============================================================================*/
+
+  /**
+   * @brief Start a transition from the shown picture to displayBuffer
+   * @param type: TRANS_CUT/WIPE/MORPH/DISSOLVE, optionally | TRANS_RAMP
+   * @param steps: Number of Trans_Step() calls (1-255)
+   * @note Restores displayBuffer to the shown picture until the first step
+   */
+  void Trans_Start(uint8_t type, uint8_t steps);
+
+  /**
+   * @brief Advance one step, updating displayBuffer and brightness
+   * @return 1 while more steps remain, 0 when finished (or idle)
+   * @note Does not flush - the scheduler flush path sends the changed grids
+   */
+  uint8_t Trans_Step(void);
+
+  /**
+   * @brief Check whether a transition is running
+   * @return 1 if running, 0 if idle
+   */
+  uint8_t Trans_Busy(void);
+
+  #endif /* __TRANSITION_H */